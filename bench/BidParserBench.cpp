@@ -0,0 +1,59 @@
+//
+// Created by Brett on 10/16/2026.
+// Compares ParseBid with the std::istringstream parsing Player::MakeGuess used before it.
+//
+
+#include "BidParser.hpp"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+constexpr int ITERATIONS = 2'000'000;
+
+// Only the "3,4" forms are understood by the old path
+constexpr std::array<std::string_view, 8> INPUTS = {
+    "3,4", "12,6", " 2 , 5", "7,1", "1,2", "10,3", "4,4", "25,6",
+};
+
+std::pair<int, int> ParseWithStream(std::string_view text) {
+  std::istringstream iss{std::string(text)};
+  int quantity = 0, face_value = 0;
+  char comma = 0;
+  if (iss >> quantity >> comma >> face_value && comma == ',') {
+    return {quantity, face_value};
+  }
+  return {0, 0};
+}
+
+std::pair<int, int> ParseWithBidParser(std::string_view text) {
+  return ParseBid(text).value_or(std::pair{0, 0});
+}
+
+template <typename Parse>
+void Measure(const char* name, Parse parse) {
+  long long checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    auto [quantity, face_value] = parse(INPUTS[i % INPUTS.size()]);
+    checksum += quantity * 7 + face_value;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << name << ": " << elapsed.count() * 1e9 / ITERATIONS << " ns/bid, "
+            << ITERATIONS / elapsed.count() / 1e6 << " M bids/s (checksum " << checksum << ")\n";
+}
+
+} // namespace
+
+int main() {
+  Measure("istringstream", ParseWithStream);
+  Measure("ParseBid     ", ParseWithBidParser);
+  return EXIT_SUCCESS;
+}
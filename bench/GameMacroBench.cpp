@@ -0,0 +1,260 @@
+//
+// Created by Brett on 10/16/2026.
+// Macrobenchmark of complete games: bots play fixed-seed batches of games through
+// Game::PlayGameAsync on a TableScheduler, one table at a time, so every turn runs the real game
+// flow from bid request to the next player. The best of several runs is compared with a JSON
+// baseline; the benchmark fails when games/s drops, or the p50 or p99 turn latency grows, by more
+// than the threshold. A baseline of other games, players or seed is refused, and a missing one is
+// recorded instead.
+//
+// A turn is the time from one bid request to the next within a game: the bot's bid, its
+// validation, the liar-call decision and moving on to the next player.
+//
+// Usage: GameMacroBench [--games <n>] [--players <n>] [--seed <n>] [--runs <n>]
+//                       [--baseline <file>] [--threshold <percent>] [--update]
+//
+
+#include "BotDecisions.hpp"
+#include "Dice.hpp"
+#include "Game.hpp"
+#include "PlayerDecisions.hpp"
+#include "TableScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::uint64_t CHECKSUM_MASK = (std::uint64_t{1} << 48) - 1;
+
+struct Options {
+  std::uint64_t games = 100'000;
+  int players = 4;
+  std::uint32_t seed = 1;
+  int runs = 5;
+  std::string baselinePath = "GameMacroBench.json";
+  double threshold = 10;  // Percent
+  bool update = false;
+};
+
+struct Result {
+  std::uint64_t games = 0;
+  std::uint64_t turns = 0;
+  std::uint64_t outcomeChecksum = 0;  // Same seed, same games: differs only if the games played differ
+  double gamesPerSecond = 0;
+  double turnP50 = 0;  // Nanoseconds
+  double turnP99 = 0;
+};
+
+// Bots that time every turn
+class TimedBots : public PlayerDecisions {
+public:
+  TimedBots(std::uint32_t seed, const GameConfig& config, std::vector<std::uint32_t>& turns)
+      : bots(seed, {}, static_cast<int>(config.faces), config.rules), turns(turns) {}
+
+  void RequestGuess(GuessRequest& request) override {
+    auto now = std::chrono::steady_clock::now();
+    if (lastRequest) {
+      turns.push_back(static_cast<std::uint32_t>(std::chrono::nanoseconds(now - *lastRequest).count()));
+    }
+    lastRequest = now;
+    bots.RequestGuess(request);
+  }
+
+  void RequestLiarCall(LiarCallRequest& request) override { bots.RequestLiarCall(request); }
+
+  // The first turn of a game has no previous request to measure from
+  void NewGame() { lastRequest.reset(); }
+
+private:
+  BotDecisions bots;
+  std::vector<std::uint32_t>& turns;
+  std::optional<std::chrono::steady_clock::time_point> lastRequest;
+};
+
+double Percentile(std::vector<std::uint32_t>& values, double fraction) {
+  if (values.empty()) {
+    return 0;
+  }
+  auto nth = values.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(values.size() - 1));
+  std::nth_element(values.begin(), nth, values.end());
+  return *nth;
+}
+
+Result Run(const Options& options) {
+  auto config = DefaultGameConfig();
+  Dice::Seed(options.seed);
+  std::vector<std::uint32_t> turns;
+  turns.reserve(options.games * 8);
+  TimedBots decisions(options.seed, *config, turns);
+  TableScheduler scheduler;
+  Game game;
+  game.SetConfig(config);
+
+  Result result;
+  std::function<void()> startNextGame = [&] {
+    if (result.games == options.games) {
+      return;
+    }
+    ++result.games;
+    game.ResetTable(options.players);
+    game.RollDice();
+    decisions.NewGame();
+    scheduler.Spawn(game.PlayGameAsync(decisions), [&] {
+      const GameOutcome& outcome = game.GetLastOutcome();
+      // Kept to 48 bits so the JSON number reads back exactly
+      result.outcomeChecksum =
+          (result.outcomeChecksum * 31 + static_cast<std::uint64_t>(outcome.WinnerId() * 64 + outcome.bids)) &
+          CHECKSUM_MASK;
+      startNextGame();
+    });
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  startNextGame();
+  scheduler.Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  result.turns = turns.size();
+  result.gamesPerSecond = static_cast<double>(result.games) / elapsed.count();
+  result.turnP50 = Percentile(turns, 0.50);
+  result.turnP99 = Percentile(turns, 0.99);
+  return result;
+}
+
+std::string ToJson(const Options& options, const Result& result) {
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"games\": " << result.games << ",\n"
+       << "  \"players\": " << options.players << ",\n"
+       << "  \"seed\": " << options.seed << ",\n"
+       << "  \"turns\": " << result.turns << ",\n"
+       << "  \"outcome_checksum\": " << result.outcomeChecksum << ",\n"
+       << "  \"games_per_sec\": " << result.gamesPerSecond << ",\n"
+       << "  \"turn_p50_ns\": " << result.turnP50 << ",\n"
+       << "  \"turn_p99_ns\": " << result.turnP99 << "\n"
+       << "}\n";
+  return json.str();
+}
+
+// Reads the number stored under "key" in the flat JSON object written by ToJson
+std::optional<double> JsonNumber(const std::string& json, std::string_view key) {
+  std::string quoted = "\"" + std::string(key) + "\"";
+  std::size_t at = json.find(quoted);
+  if (at == std::string::npos || (at = json.find(':', at + quoted.size())) == std::string::npos) {
+    return std::nullopt;
+  }
+  const char* first = json.c_str() + at + 1;
+  char* last = nullptr;
+  double value = std::strtod(first, &last);
+  return last == first ? std::nullopt : std::optional(value);
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--games" && hasValue) {
+      options.games = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--players" && hasValue) {
+      options.players = std::max(2, std::atoi(argv[++i]));
+    } else if (arg == "--seed" && hasValue) {
+      options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--runs" && hasValue) {
+      options.runs = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--baseline" && hasValue) {
+      options.baselinePath = argv[++i];
+    } else if (arg == "--threshold" && hasValue) {
+      options.threshold = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--update") {
+      options.update = true;
+    } else {
+      return false;
+    }
+  }
+  return options.games > 0;
+}
+
+// Prints one metric against the baseline; returns false if it regressed beyond the threshold
+bool Compare(std::string_view name, double current, std::optional<double> baseline, bool higher_is_better,
+             double threshold) {
+  std::cout << "  " << name << ": " << current;
+  if (!baseline || *baseline <= 0) {
+    std::cout << " (not in baseline)\n";
+    return true;
+  }
+  double change = (current - *baseline) / *baseline * 100;
+  double regression = higher_is_better ? -change : change;
+  bool ok = regression <= threshold;
+  std::cout << " vs " << *baseline << " (" << (change >= 0 ? "+" : "") << change << "%)"
+            << (ok ? "" : "  REGRESSION") << '\n';
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr << "Usage: GameMacroBench [--games <n>] [--players <n>] [--seed <n>] [--runs <n>]\n"
+                 "                      [--baseline <file>] [--threshold <percent>] [--update]\n";
+    return EXIT_FAILURE;
+  }
+
+  // The fastest run is the one least disturbed by the rest of the machine
+  Result best;
+  for (int run = 0; run < options.runs; ++run) {
+    Result result = Run(options);
+    if (result.gamesPerSecond > best.gamesPerSecond) {
+      best = result;
+    }
+  }
+  std::cout << best.games << " games, " << best.turns << " turns, " << options.players << " players, seed "
+            << options.seed << '\n';
+
+  std::string baseline;
+  if (std::ifstream file(options.baselinePath); file && !options.update) {
+    baseline.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  if (baseline.empty()) {
+    std::ofstream file(options.baselinePath);
+    if (!(file << ToJson(options, best)) || !file.flush()) {
+      std::cerr << "Could not write " << options.baselinePath << '\n';
+      return EXIT_FAILURE;
+    }
+    std::cout << "  games/s: " << best.gamesPerSecond << "\n  turn p50: " << best.turnP50
+              << " ns\n  turn p99: " << best.turnP99 << " ns\nBaseline written to " << options.baselinePath << '\n';
+    return EXIT_SUCCESS;
+  }
+
+  // Timings are only comparable over the same fixed-seed games
+  if (JsonNumber(baseline, "games") != static_cast<double>(best.games) ||
+      JsonNumber(baseline, "players") != static_cast<double>(options.players) ||
+      JsonNumber(baseline, "seed") != static_cast<double>(options.seed)) {
+    std::cout << options.baselinePath << " was recorded with other --games, --players or --seed; run with those, "
+              << "or record a new baseline with --update\n";
+    return EXIT_FAILURE;
+  }
+  if (JsonNumber(baseline, "outcome_checksum") != static_cast<double>(best.outcomeChecksum)) {
+    std::cout << "Warning: these games differ from the baseline's (the game or bots changed)\n";
+  }
+  bool ok = Compare("games/s", best.gamesPerSecond, JsonNumber(baseline, "games_per_sec"), true, options.threshold);
+  ok &= Compare("turn p50 (ns)", best.turnP50, JsonNumber(baseline, "turn_p50_ns"), false, options.threshold);
+  ok &= Compare("turn p99 (ns)", best.turnP99, JsonNumber(baseline, "turn_p99_ns"), false, options.threshold);
+  if (!ok) {
+    std::cout << "Slower than " << options.baselinePath << " by more than " << options.threshold << "%\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Within " << options.threshold << "% of " << options.baselinePath << '\n';
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+//
+// Created by Brett on 10/16/2026.
+// Microbenchmarks of the game's hot functions at table sizes from 2 to 10^6 players: Dice::Roll,
+// Player::RollDice, Game::ValidateGuess, Game::CheckGuessAgainstDice and the bid parsing in
+// Player::MakeGuess. Every row reports ns/op and the heap allocations and bytes allocated per op,
+// counted by replacing the global operator new. Run it before and after changing one of them.
+//
+// Usage: LiarsDiceBench [max-players]   (default 1000000)
+//
+
+#include "Dice.hpp"
+#include "Game.hpp"
+#include "Guess.hpp"
+#include "LineReader.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::uint64_t allocationCount = 0;
+std::uint64_t allocatedBytes = 0;
+
+constexpr std::array<int, 7> TABLE_SIZES = {2, 10, 100, 1'000, 10'000, 100'000, 1'000'000};
+constexpr std::chrono::milliseconds MIN_TIME(100);  // Per row, after one warm-up batch
+constexpr std::size_t GUESS_PAIRS = 1024;           // Distinct (new, last) guesses cycled through
+
+// Keeps results observable so the measured calls are not optimised away
+std::uint64_t checksum = 0;
+
+// Runs 'batch', which performs 'ops_per_batch' operations, until MIN_TIME has passed and prints
+// the per-operation cost
+template <typename Batch>
+void Measure(std::string_view name, int players, std::uint64_t ops_per_batch, Batch batch) {
+  batch();
+
+  std::uint64_t batches = 0;
+  std::uint64_t allocationsBefore = allocationCount;
+  std::uint64_t bytesBefore = allocatedBytes;
+  auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration elapsed;
+  do {
+    batch();
+    ++batches;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < MIN_TIME);
+
+  auto ops = static_cast<double>(batches * ops_per_batch);
+  std::cout << std::left << std::setw(30) << name << std::right << std::setw(9) << players << std::fixed
+            << std::setprecision(2) << std::setw(12) << std::chrono::duration<double, std::nano>(elapsed).count() / ops
+            << std::setw(12) << static_cast<double>(allocationCount - allocationsBefore) / ops << std::setw(12)
+            << static_cast<double>(allocatedBytes - bytesBefore) / ops << '\n';
+}
+
+// Typed bids, in the forms ParseBid accepts, handed to Player::MakeGuess as if read from the console
+class CannedBids final : public LineReader {
+public:
+  ReadStatus ReadLine(std::string_view, std::string& line, Clock::time_point) override {
+    line = BIDS[next++ % BIDS.size()];
+    return ReadStatus::Line;
+  }
+
+  [[nodiscard]] bool Interactive() const override { return false; }
+
+private:
+  static constexpr std::array<std::string_view, 8> BIDS = {
+      "3,4", "12, 6", "2 5", "seven ones", "1,2", "10 threes", "four fours", "25,6",
+  };
+  std::size_t next = 0;
+};
+
+// Raises of a standing bid; 'valid' picks the smallest legal raise, otherwise one die fewer on the
+// same face, which every rule variant rejects
+std::vector<std::pair<Guess, Guess>> MakeGuesses(int total_dice, bool valid, std::mt19937& rng) {
+  std::uniform_int_distribution<int> count(2, std::max(2, total_dice / 3));
+  std::uniform_int_distribution<int> face(1, static_cast<int>(Dice::kDefaultFaces));
+  std::vector<std::pair<Guess, Guess>> guesses;
+  guesses.reserve(GUESS_PAIRS);
+  for (std::size_t i = 0; i < GUESS_PAIRS; ++i) {
+    Guess last({count(rng), face(rng)});
+    Guess next(valid ? MinimumRaise(last) : std::pair{last.diceCount - 1, last.diceValue});
+    guesses.emplace_back(next, last);
+  }
+  return guesses;
+}
+
+void BenchmarkPlayers(int players) {
+  std::vector<Player> table;
+  table.reserve(players);
+  for (int id = 1; id <= players; ++id) {
+    table.emplace_back(id);
+  }
+
+  std::vector<Dice> dice(static_cast<std::size_t>(players) * Player::kDefaultDiceCount);
+  Measure("Dice::Roll", players, dice.size(), [&] {
+    for (auto& die : dice) {
+      die.Roll();
+    }
+    checksum += dice.back().GetFaceValue();
+  });
+
+  Measure("Player::RollDice", players, table.size(), [&] {
+    for (auto& player : table) {
+      player.RollDice();
+    }
+    checksum += table.back().GetDice().front().GetFaceValue();
+  });
+
+  CannedBids bids;
+  constexpr std::uint64_t GUESSES_PER_BATCH = 1024;
+  std::size_t next = 0;
+  Measure("Player::MakeGuess (parse)", players, GUESSES_PER_BATCH, [&] {
+    for (std::uint64_t i = 0; i < GUESSES_PER_BATCH; ++i) {
+      auto bid = table[next++ % table.size()].MakeGuess(bids);
+      checksum += static_cast<std::uint64_t>(bid->first + bid->second);
+    }
+  });
+}
+
+void BenchmarkGame(int players) {
+  Game game;
+  game.ResetTable(players);
+  int totalDice = players * Player::kDefaultDiceCount;
+  std::mt19937 rng(players);
+
+  for (bool valid : {true, false}) {
+    auto guesses = MakeGuesses(totalDice, valid, rng);
+    Measure(valid ? "Game::ValidateGuess (valid)" : "Game::ValidateGuess (invalid)", players, guesses.size(), [&] {
+      for (const auto& [guess, last] : guesses) {
+        checksum += game.ValidateGuess(guess, last).size();
+      }
+    });
+  }
+
+  // Every call counts all the dice on the table; keep a batch at roughly 64k dice
+  auto guesses = MakeGuesses(totalDice, true, rng);
+  std::size_t calls = std::clamp<std::size_t>(65'536 / static_cast<std::size_t>(totalDice), 1, guesses.size());
+  Measure("Game::CheckGuessAgainstDice", players, calls, [&] {
+    for (std::size_t i = 0; i < calls; ++i) {
+      checksum += game.CheckGuessAgainstDice(guesses[i].second).size();
+    }
+  });
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  ++allocationCount;
+  allocatedBytes += size;
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+int main(int argc, char* argv[]) {
+  int maxPlayers = argc > 1 ? std::atoi(argv[1]) : TABLE_SIZES.back();
+
+  std::cout << std::left << std::setw(30) << "benchmark" << std::right << std::setw(9) << "players" << std::setw(12)
+            << "ns/op" << std::setw(12) << "allocs/op" << std::setw(12) << "bytes/op" << '\n';
+  for (int players : TABLE_SIZES) {
+    if (players > maxPlayers) {
+      break;
+    }
+    BenchmarkPlayers(players);
+    BenchmarkGame(players);
+  }
+  std::cout << "(checksum " << checksum << ")\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+//
+// Created by Brett on 10/16/2026.
+// Drives the Matchmaker from many producer threads, the way connection threads enqueue waiting
+// players, and reports the sustained enqueue rate and queue depth.
+//
+
+#include "Matchmaker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int PRODUCERS = 32;
+constexpr int PLAYERS_PER_PRODUCER = 250'000;
+constexpr int TABLE_SIZE = 4;
+constexpr std::size_t QUEUE_CAPACITY = 1 << 16;
+
+} // namespace
+
+int main() {
+  std::uint64_t seatedChecksum = 0;  // Seating thread only
+  Matchmaker<std::uint32_t> matchmaker(TABLE_SIZE, QUEUE_CAPACITY, [&](std::vector<std::uint32_t>& group) {
+    for (std::uint32_t player : group) {
+      seatedChecksum += player;
+    }
+  });
+  matchmaker.Start();
+
+  std::vector<std::thread> producers;
+  auto start = std::chrono::steady_clock::now();
+  for (int producer = 0; producer < PRODUCERS; ++producer) {
+    producers.emplace_back([&matchmaker, producer] {
+      for (int i = 0; i < PLAYERS_PER_PRODUCER; ++i) {
+        auto player = static_cast<std::uint32_t>(producer * PLAYERS_PER_PRODUCER + i);
+        while (!matchmaker.Enqueue(std::uint32_t{player})) {
+          std::this_thread::yield();  // Full: a real loop would turn the player away
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  std::chrono::duration<double> enqueueTime = std::chrono::steady_clock::now() - start;
+
+  constexpr std::uint64_t total = std::uint64_t{PRODUCERS} * PLAYERS_PER_PRODUCER;
+  while (matchmaker.Stats().tablesSeated < total / TABLE_SIZE) {
+    std::this_thread::yield();
+  }
+  std::chrono::duration<double> seatTime = std::chrono::steady_clock::now() - start;
+  matchmaker.Stop();
+
+  MatchmakingStats stats = matchmaker.Stats();
+  std::cout << PRODUCERS << " producers, " << total << " players, tables of " << TABLE_SIZE << '\n'
+            << "Enqueue: " << total / enqueueTime.count() / 1e6 << " M players/s\n"
+            << "Seated:  " << stats.tablesSeated << " tables in " << seatTime.count() * 1e3 << " ms\n"
+            << "Queue:   " << stats.rejected << " full rejections, depth peaked at " << stats.maxDepth << " of "
+            << QUEUE_CAPACITY << '\n'
+            << "Checksum " << (seatedChecksum == total * (total - 1) / 2 ? "ok" : "MISMATCH") << '\n';
+  return seatedChecksum == total * (total - 1) / 2 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
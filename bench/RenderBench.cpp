@@ -0,0 +1,62 @@
+//
+// Created by Brett on 10/16/2026.
+// Per-turn redraw cost of the console game: the system("cls") it used to run every turn against
+// one TerminalRenderer frame (rules, state and prompt) written to /dev/null, drawn in full and as
+// the difference from the previous turn.
+//
+
+#include "EmbeddedAssets.hpp"
+#include "Player.hpp"
+#include "TerminalRenderer.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr int SHELL_TURNS = 200;
+constexpr int FRAME_TURNS = 200'000;
+
+} // namespace
+
+int main() {
+  Player player(1);
+
+  // The shell is spawned whether or not it knows "cls"; its output is discarded either way
+  auto start = std::chrono::steady_clock::now();
+  for (int turn = 0; turn < SHELL_TURNS; ++turn) {
+    [[maybe_unused]] int status = std::system("cls >/dev/null 2>&1");
+  }
+  std::chrono::duration<double, std::micro> shellTime = std::chrono::steady_clock::now() - start;
+
+  int sink = ::open("/dev/null", O_WRONLY);
+  TerminalRenderer screen(sink);
+  std::size_t fullBytes = 0;
+  std::size_t diffBytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (int turn = 0; turn < FRAME_TURNS; ++turn) {
+    bool full = turn < FRAME_TURNS / 2;
+    if (full) {
+      screen.Invalidate();
+    }
+    screen.BeginFrame();
+    screen << kEmbeddedRulesText << "PLAYER " << player.GetPlayerId() << "'s Turn:\n"
+           << "Last Guess: " << turn % 20 << ", " << turn % 6 + 1 << '\n'
+           << "Your Dice: ";
+    player.DisplayDice(screen);
+    screen << '\n' << Player::kGuessPrompt;
+    screen.Present();
+    (full ? fullBytes : diffBytes) += screen.LastWriteSize();
+  }
+  std::chrono::duration<double, std::micro> frameTime = std::chrono::steady_clock::now() - start;
+  ::close(sink);
+
+  std::cout << "system(\"cls\"):    " << shellTime.count() / SHELL_TURNS << " us/turn\n"
+            << "TerminalRenderer: " << frameTime.count() / FRAME_TURNS << " us/turn, one write of "
+            << fullBytes / (FRAME_TURNS / 2) << " bytes redrawing in full, " << diffBytes / (FRAME_TURNS / 2)
+            << " bytes redrawing the difference\n";
+  return EXIT_SUCCESS;
+}
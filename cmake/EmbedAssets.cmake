@@ -0,0 +1,38 @@
+# Writes a header that embeds the default game settings and rules text as constant data, so the
+# game never has to find assets/ at run time. Run as a script:
+#   cmake -DCONFIG=<game.cfg> -DRULES=<rules.txt> -DOUTPUT=<header> -P EmbedAssets.cmake
+
+# Appends "inline constexpr std::string_view <name>" holding the bytes of <file> to <out_var>
+function(embed_file file name out_var)
+    file(READ "${file}" hex HEX)
+    string(LENGTH "${hex}" length)
+    set(bytes "")
+    # Sixteen bytes per line
+    foreach(offset RANGE 0 ${length} 32)
+        string(SUBSTRING "${hex}" ${offset} 32 chunk)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "'\\\\x\\1'," chunk "${chunk}")
+        if(NOT chunk STREQUAL "")
+            string(APPEND bytes "${chunk}\n    ")
+        endif()
+    endforeach()
+    set(${out_var} "${${out_var}}
+inline constexpr char ${name}Data[] = {
+    ${bytes}'\\0'};
+inline constexpr std::string_view ${name}(${name}Data, sizeof(${name}Data) - 1);
+" PARENT_SCOPE)
+endfunction()
+
+set(contents "// Generated from assets/ by cmake/EmbedAssets.cmake; do not edit.
+
+#ifndef LIARSDICE_EMBEDDEDASSETS_HPP
+#define LIARSDICE_EMBEDDEDASSETS_HPP
+
+#include <string_view>
+")
+embed_file("${CONFIG}" kEmbeddedGameConfig contents)
+embed_file("${RULES}" kEmbeddedRulesText contents)
+string(APPEND contents "
+#endif //LIARSDICE_EMBEDDEDASSETS_HPP
+")
+
+file(WRITE "${OUTPUT}" "${contents}")
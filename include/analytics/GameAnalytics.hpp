@@ -0,0 +1,58 @@
+//
+// Created by Brett on 10/16/2026.
+// Aggregate statistics over recorded games: bluff rate, liar-call accuracy by how likely the called
+// bid looked to the caller, spot-on accuracy, first-player advantage and round length. Dice are
+// counted under the rule variant and faces per die recorded with each game.
+// Blocks of an event log are scanned in parallel, each worker filling its own AnalyticsPartial;
+// the partials are merged once at the end.
+//
+
+#ifndef LIARSDICE_INCLUDE_ANALYTICS_GAMEANALYTICS_HPP
+#define LIARSDICE_INCLUDE_ANALYTICS_GAMEANALYTICS_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ReplayReader.hpp"
+
+struct AnalyticsPartial {
+  static constexpr int kProbabilityBuckets = 10;
+
+  std::uint64_t games = 0;
+  std::uint64_t bids = 0;          // Accepted bids
+  std::uint64_t rejectedBids = 0;
+  std::uint64_t bluffs = 0;        // Accepted bids that claimed more dice than were on the table
+  std::uint64_t liarCalls = 0;
+  std::uint64_t correctCalls = 0;  // Liar calls won by the calling player
+  std::uint64_t spotOnCalls = 0;
+  std::uint64_t correctSpotOnCalls = 0;
+  // Liar calls bucketed by the probability, seen from the caller's own dice, that the called bid was true
+  std::array<std::uint64_t, kProbabilityBuckets> callsByBucket{};
+  std::array<std::uint64_t, kProbabilityBuckets> correctCallsByBucket{};
+  std::uint64_t firstBidderWins = 0;
+  double expectedFirstBidderWins = 0;  // Sum of 1 / players, the win count with no advantage
+  // Games from older logs that recorded the bidder as the caller: the real caller's hand and the winner
+  // of a successful call are unknown, so they are left out of the call buckets and first-player advantage
+  std::uint64_t selfCalledGames = 0;
+  std::uint64_t corruptBlocks = 0;
+
+  void Merge(const AnalyticsPartial& other);
+};
+
+class GameAnalytics {
+public:
+  // Scans every block of the log using up to 'threads' workers (0 = one per hardware thread)
+  static AnalyticsPartial Scan(const ReplayReader& reader, unsigned threads = 0);
+
+  // Adds the games of one block to 'partial'
+  static void ScanBlock(const EventBlock& block, AnalyticsPartial& partial);
+
+  static void PrintReport(const AnalyticsPartial& totals, std::ostream& out);
+};
+
+// Scans all logs and prints the report; returns the process exit code for 'LiarsDice --analyze'
+int RunAnalytics(const std::vector<std::string>& filenames);
+
+#endif //LIARSDICE_INCLUDE_ANALYTICS_GAMEANALYTICS_HPP
@@ -0,0 +1,41 @@
+//
+// Created by Brett on 10/16/2026.
+// Simple computer players for Game::PlayGameAsync, with optional think-time.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_BOTDECISIONS_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_BOTDECISIONS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include "PlayerDecisions.hpp"
+#include "RuleEngine.hpp"
+
+// Plays every seat of a table. Bots bid on the face they hold most of, bluff now and then, and call
+// "Liar" once the standing bid looks unlikely given their own dice, under the table's rule variant.
+class BotDecisions : public PlayerDecisions {
+public:
+  static constexpr int kMaxFaces = 15;
+
+  explicit BotDecisions(std::uint32_t seed, std::chrono::microseconds think_time = {},
+                        int faces = Dice::kDefaultFaces, RuleVariant rules = {});
+
+  void RequestGuess(GuessRequest& request) override;
+  void RequestLiarCall(LiarCallRequest& request) override;
+
+private:
+  std::mt19937 rng;
+  std::chrono::microseconds thinkTime;
+  int faces;  // Faces of the table's dice
+  RuleVariant rules;
+
+  // Delivers the decision after the bot's think-time, or immediately when it has none
+  template <typename T>
+  void answer(DecisionRequest<T>& request, T decision);
+
+  static std::array<int, kMaxFaces + 1> countFaces(const Player& player);
+};
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_BOTDECISIONS_HPP
@@ -6,21 +6,43 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <utility>
+#include "GameConfig.hpp"
+#include "Guess.hpp"
 #include "Player.hpp"
+#include "PlayerDecisions.hpp"
+#include "RuleEngine.hpp"
+#include "TableScheduler.hpp"
+#include "TerminalRenderer.hpp"
 
-// Struct to represent a guess
-struct Guess {
-  int diceValue;
-  int diceCount;
+class EventLogWriter;
+class LineReader;
 
-  // Convert pair<int, int> into Guess
-  explicit Guess(std::pair<int, int> guess_pair) {
-    diceCount = guess_pair.first;
-    diceValue = guess_pair.second;
-  }
+// Winners reported by Game::CheckGuessAgainstDice
+inline const std::string GUESSING_PLAYER = "Guessing Player";
+inline const std::string CALLING_PLAYER = "Calling Player";
+
+// Summary of one finished game, produced when a liar call is resolved
+struct GameOutcome {
+  int numPlayers = 0;
+  int bids = 0;  // Accepted bids, i.e. the length of the round
+  int rejectedBids = 0;
+  int finalDiceCount = 0;  // The bid that was called
+  int finalDiceValue = 0;
+  int actualCount = 0;  // Dice on the table showing finalDiceValue
+  int guessingPlayerId = 0;
+  int callingPlayerId = 0;
+  CallType call = CallType::Liar;
+  bool guesserWon = false;
+
+  [[nodiscard]] int WinnerId() const { return guesserWon ? guessingPlayerId : callingPlayerId; }
 };
 
 class Game {
@@ -30,29 +52,93 @@ public:
   // Initializes the game
   void Init();
 
-  // Reads game rules from a file
-  std::string ReadRulesFromFile(const std::string& filename);
+  // Uses the given settings (dice, faces, rule variant, rules text) from the next ResetTable on
+  void SetConfig(std::shared_ptr<const GameConfig> game_config);
+  [[nodiscard]] const GameConfig& GetConfig() const { return *config; }
 
   // Sets up players for the game
   void SetupPlayers();
 
+  // Seats num_players players (ids 1..num_players) and clears the last guess and turn order.
+  // Existing players are kept so their dice do not have to be reconstructed.
+  void ResetTable(int num_players);
+
+  // Rolls every player's dice for a new game
+  void RollDice();
+
+  // Overrides the dice of the player with the given id, e.g. when re-simulating a recorded game.
+  // Throws GameLogicException for an unknown id or a face value the configured dice cannot show.
+  void SetPlayerDice(int player_id, std::span<const std::uint8_t> faces);
+
+  [[nodiscard]] int GetPlayerCount() const { return static_cast<int>(players.size()); }
+  [[nodiscard]] const std::vector<Player>& GetPlayers() const { return players; }
+
+  // Turn state of a game in progress, e.g. for checkpoints
+  [[nodiscard]] int GetCurrentPlayerIndex() const { return currentPlayerIndex; }
+  [[nodiscard]] const Guess& GetLastGuess() const { return lastGuess; }
+
+  // Puts a restored table back mid-game: the next PlayGameAsync continues with the given player
+  // and bid, asking for the liar call on that bid first if 'awaiting_call' is set
+  void RestoreTurn(int current_player_index, const Guess& last_guess, bool awaiting_call);
+
   // Main game loop
   void PlayGame();
 
+  // Reads the console game's answers from 'reader' instead of the terminal. A reader that is not
+  // interactive, such as a script, also turns off the rules text, prompts and screen redraws.
+  void SetInput(LineReader& reader) { input = &reader; }
+
+  // Gives console players 'turn_time' for each bid and each liar call (0 = no limit). A player who
+  // runs out of it makes the move the server makes for them: the smallest raise, or a liar call.
+  void SetTurnTime(std::chrono::milliseconds turn_time) { turnTime = turn_time; }
+
+  // The same game loop as a coroutine: decisions are awaited from 'decisions' instead of being read
+  // from std::cin, so a single TableScheduler thread can run thousands of tables at once.
+  // The table must be set up (ResetTable, RollDice) before the task is spawned.
+  GameTask PlayGameAsync(PlayerDecisions& decisions);
+
   // Validates a new guess against the last guess
   std::string ValidateGuess(const Guess& new_guess, const Guess& last_guess);
 
   // Checks the last guess against the actual dice
-  std::string CheckGuessAgainstDice(const Guess& last_guess);
+  std::string CheckGuessAgainstDice(const Guess& last_guess, CallType call = CallType::Liar);
+
+  // Selects the rule variant for the following games (classic rules by default)
+  void SetRules(RuleVariant variant);
+  [[nodiscard]] RuleVariant GetRules() const { return rules->variant; }
+
+  // Outcome of the most recently resolved game
+  [[nodiscard]] const GameOutcome& GetLastOutcome() const { return lastOutcome; }
+
+  // Records every roll, bid, liar call and resolution to the given writer (nullptr disables logging)
+  void SetEventLog(EventLogWriter* writer) { eventLog = writer; }
 
 private:
   std::vector<Player> players;
   int currentPlayerIndex;
   Guess lastGuess;
-  std::string rulesText;
+  std::shared_ptr<const GameConfig> config;
+  EventLogWriter* eventLog = nullptr;
+  GameOutcome lastOutcome;
+  int diceInPlay = 0;
+  const RuleTable* rules;
+  bool palificoRound = false;
+  bool resumeAtCall = false;  // Set by RestoreTurn
+  TerminalRenderer screen;    // Console games only
+  LineReader* input;          // Console games only
+  std::chrono::milliseconds turnTime{0};
+  void beginGame();
+  void updatePalificoRound();
+  std::string applyGuess(const Player& player, const Guess& guess);
+  std::string resolveCall(const Player& caller, CallType call);
+  [[nodiscard]] int countMatchingDice(int dice_value) const;
+  void recordOutcome(int calling_player_id, CallType call, const std::string& winner);
+  // The player after the current one, who may challenge the current player's bid
+  Player& nextPlayer();
   void updateCurrentPlayerIndex();
-  void displayCurrentState(Player &currentPlayer) const;
-  void GetSetupInput(int &num_players);
+  void displayCurrentState(const Player& currentPlayer);
+  [[nodiscard]] Player::Deadline turnDeadline() const;
+  void GetSetupInput(std::string_view prompt, int &num_players);
 };
 
 #endif //GAME_HPP
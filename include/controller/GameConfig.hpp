@@ -0,0 +1,39 @@
+//
+// Created by Brett on 10/16/2026.
+// Game settings, read once and then shared read-only by every game and table. The defaults are
+// assets/game.cfg and assets/rules.txt, compiled into the binary; a config file given at run time
+// overrides them.
+//
+// File format, one "key = value" per line, '#' starts a comment:
+//   dice_per_player = 5
+//   faces           = 6           # 2 to 15
+//   rules           = classic     # as for --rules: classic, wild-ones, spot-on, palifico
+//   rules_text      = rules.txt   # shown before every turn, relative to the config file;
+//                                 # the built-in rules text if omitted
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_GAMECONFIG_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_GAMECONFIG_HPP
+
+#include <memory>
+#include <string>
+#include "Dice.hpp"
+#include "Player.hpp"
+#include "RuleEngine.hpp"
+
+struct GameConfig {
+  static constexpr unsigned kMaxFaces = 15;  // Faces travel as nibbles on the wire
+
+  int dicePerPlayer = Player::kDefaultDiceCount;
+  unsigned faces = Dice::kDefaultFaces;
+  RuleVariant rules;
+  std::string rulesText;
+};
+
+// Parses the config file and the rules text it names; throws FileException
+GameConfig LoadGameConfig(const std::string& filename);
+
+// The settings and rules text built into the binary; never touches the filesystem
+const std::shared_ptr<const GameConfig>& DefaultGameConfig();
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_GAMECONFIG_HPP
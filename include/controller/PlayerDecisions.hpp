@@ -0,0 +1,103 @@
+//
+// Created by Brett on 10/16/2026.
+// Awaitable player decisions for Game::PlayGameAsync.
+// The game loop co_awaits a DecisionRequest; the PlayerDecisions implementation (bot, network
+// seat, ...) receives the request and completes it whenever the answer is known, which resumes the
+// game on its TableScheduler.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_PLAYERDECISIONS_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_PLAYERDECISIONS_HPP
+
+#include <coroutine>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Guess.hpp"
+#include "Player.hpp"
+#include "TableScheduler.hpp"
+
+class PlayerDecisions;
+
+template <typename T>
+class DecisionRequest {
+public:
+  DecisionRequest(PlayerDecisions& decisions, const Player& player, const Guess& last_guess, int total_dice,
+                  bool palifico_round = false)
+      : player(player), lastGuess(last_guess), totalDice(total_dice), palificoRound(palifico_round),
+        decisions(decisions) {}
+
+  DecisionRequest(const DecisionRequest&) = delete;
+  DecisionRequest& operator=(const DecisionRequest&) = delete;
+
+  const Player& player;  // The player whose decision is awaited
+  Guess lastGuess;       // The bid currently standing on the table
+  int totalDice;         // Dice in play across all players
+  bool palificoRound;    // Palifico rules apply: ones are not wild and an opened bid keeps its face
+  // Liar calls only: the player after the bidder, who decides and is recorded as the caller
+  const Player* caller = nullptr;
+
+  // Delivers the decision and resumes the game on its scheduler
+  void Complete(T decision) {
+    value = std::move(decision);
+    if (suspending) {
+      completedInline = true;  // Still inside await_suspend: just don't suspend
+    } else {
+      scheduler->Post(waiter);
+    }
+  }
+
+  // Delivers the decision but resumes the game no earlier than 'when' (e.g. bot think-time)
+  void CompleteAt(T decision, TableScheduler::Clock::time_point when) {
+    value = std::move(decision);
+    scheduler->PostAt(when, waiter);
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(GameTask::Handle handle);
+
+  T await_resume() { return std::move(value); }
+
+private:
+  PlayerDecisions& decisions;
+  TableScheduler* scheduler = nullptr;
+  std::coroutine_handle<> waiter;
+  T value{};
+  bool suspending = false;
+  bool completedInline = false;
+};
+
+// A guess as (quantity, face value), matching Player::MakeGuess
+using GuessRequest = DecisionRequest<std::pair<int, int>>;
+// Whether to call "Liar" (or spot-on) on the standing bid, matching Player::CallLiar
+using LiarCallRequest = DecisionRequest<CallType>;
+
+// Source of decisions for every seat of a table
+class PlayerDecisions {
+public:
+  virtual ~PlayerDecisions() = default;
+
+  // Must eventually call Complete or CompleteAt on the request; may do so before returning
+  virtual void RequestGuess(GuessRequest& request) = 0;
+  virtual void RequestLiarCall(LiarCallRequest& request) = 0;
+
+  // Called when a guess was rejected by Game::ValidateGuess; the player is asked again afterwards
+  virtual void OnInvalidGuess([[maybe_unused]] const Player& player, [[maybe_unused]] const std::string& error) {}
+};
+
+template <typename T>
+bool DecisionRequest<T>::await_suspend(GameTask::Handle handle) {
+  scheduler = handle.promise().scheduler;
+  waiter = handle;
+  suspending = true;
+  if constexpr (std::is_same_v<T, CallType>) {
+    decisions.RequestLiarCall(*this);
+  } else {
+    decisions.RequestGuess(*this);
+  }
+  suspending = false;
+  return !completedInline;
+}
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_PLAYERDECISIONS_HPP
@@ -0,0 +1,54 @@
+//
+// Created by Brett on 10/16/2026.
+// Re-simulates recorded games through the real game rules and checks that every recorded decision
+// and outcome matches what Game::ValidateGuess and Game::CheckGuessAgainstDice produce today.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_REPLAYVERIFIER_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_REPLAYVERIFIER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Game.hpp"
+#include "GameConfig.hpp"
+#include "ReplayReader.hpp"
+
+struct ReplayReport {
+  std::uint64_t gamesVerified = 0;
+  std::uint64_t gamesIncomplete = 0;  // Games cut off before their resolution (e.g. the player quit)
+  std::uint64_t events = 0;
+  std::uint64_t mismatches = 0;
+  std::vector<std::string> mismatchDetails;  // The first few mismatches, for the report
+
+  [[nodiscard]] bool Passed() const { return mismatches == 0; }
+};
+
+class ReplayVerifier {
+public:
+  static constexpr std::size_t kMaxReportedMismatches = 10;
+
+  // Verifies every game of every block in the log
+  ReplayReport Verify(const ReplayReader& reader);
+
+  // Verifies the games of a single block, adding to 'report'
+  void VerifyBlock(const EventBlock& block, ReplayReport& report);
+
+private:
+  Game game;  // Only used for its rules and its table of players
+  // Configs seating dice of each recorded number of faces, built on first use
+  std::array<std::shared_ptr<const GameConfig>, GameConfig::kMaxFaces + 1> faceConfigs;
+
+  // Reseats the table with dice of the given faces, so rolls the recorded dice cannot show are caught
+  void useFaces(unsigned faces, const RuleVariant& rules);
+
+  void recordMismatch(ReplayReport& report, const EventBlock& block, const std::string& what);
+};
+
+// Prints the report and returns the process exit code for 'LiarsDice --replay'
+int RunReplayVerification(const std::string& filename);
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_REPLAYVERIFIER_HPP
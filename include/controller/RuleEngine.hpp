@@ -0,0 +1,100 @@
+//
+// Created by Brett on 10/16/2026.
+// Rule variants as compile-time policies.
+//
+// RuleEngine<Rules> is instantiated once per combination of variants, so every rule check compiles
+// to straight-line code for exactly that rule set. Game picks the matching instantiation once,
+// through a RuleTable of function pointers, instead of testing variant flags on every turn.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_RULEENGINE_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_RULEENGINE_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Guess.hpp"
+#include "Player.hpp"
+
+struct RuleVariant {
+  bool wildOnes = false;  // Ones count toward every face value
+  bool spotOn = false;    // The caller may claim the bid is exactly right instead of too high
+  bool palifico = false;  // When the opening player holds a single die, ones are not wild and the
+                          // face value of the opening bid cannot change
+
+  // Dense numbering of the combinations, also the id stored in event logs
+  [[nodiscard]] constexpr unsigned Index() const { return wildOnes | spotOn << 1 | palifico << 2; }
+
+  static constexpr RuleVariant FromIndex(unsigned index) {
+    return {(index & 1) != 0, (index & 2) != 0, (index & 4) != 0};
+  }
+
+  bool operator==(const RuleVariant&) const = default;
+};
+
+inline constexpr unsigned kRuleVariantCount = 8;
+
+template <RuleVariant Rules>
+struct RuleEngine {
+  // A raise must increase the count or the face value; in a palifico round only the count may move
+  static bool IsValidRaise(const Guess& next, const Guess& last, bool palifico_round) {
+    bool raised = next.diceCount > last.diceCount || next.diceValue > last.diceValue;
+    if constexpr (Rules.palifico) {
+      bool faceLocked = palifico_round && last.diceCount != 0;
+      return raised && (!faceLocked || (next.diceValue == last.diceValue && next.diceCount > last.diceCount));
+    }
+    return raised;
+  }
+
+  // Dice on the table that count toward 'dice_value'
+  static int CountMatching(const std::vector<Player>& players, int dice_value, bool palifico_round) {
+    auto target = static_cast<unsigned>(dice_value);
+    unsigned wild = target;  // Comparing twice against the same face is the no-wilds case
+    if constexpr (Rules.wildOnes) {
+      wild = (Rules.palifico && palifico_round) ? target : 1;
+    }
+    int counter = 0;
+    for (const auto& player : players) {
+      for (const auto& die : player.GetDice()) {
+        unsigned face = die.GetFaceValue();
+        counter += static_cast<int>((face == target) | (face == wild));
+      }
+    }
+    return counter;
+  }
+
+  static bool IsAllowedCall(CallType call) {
+    return call == CallType::Liar || (Rules.spotOn && call == CallType::SpotOn);
+  }
+
+  // A liar call loses if the bid holds; a spot-on call wins only if the bid is exact
+  static bool GuesserWins(CallType call, int actual_count, int bid_count) {
+    if constexpr (Rules.spotOn) {
+      if (call == CallType::SpotOn) {
+        return actual_count != bid_count;
+      }
+    }
+    return actual_count >= bid_count;
+  }
+};
+
+// One RuleEngine instantiation, bound at runtime
+struct RuleTable {
+  RuleVariant variant;
+  bool (*isValidRaise)(const Guess& next, const Guess& last, bool palifico_round);
+  int (*countMatching)(const std::vector<Player>& players, int dice_value, bool palifico_round);
+  bool (*isAllowedCall)(CallType call);
+  bool (*guesserWins)(CallType call, int actual_count, int bid_count);
+};
+
+// The table for 'variant'; the reference stays valid for the life of the program
+const RuleTable& SelectRules(RuleVariant variant);
+
+// Parses a comma-separated list of "classic", "wild-ones", "spot-on" and "palifico"
+std::optional<RuleVariant> ParseRuleVariant(std::string_view names);
+
+// The inverse of ParseRuleVariant, for reports
+std::string DescribeRuleVariant(RuleVariant variant);
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_RULEENGINE_HPP
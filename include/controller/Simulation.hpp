@@ -0,0 +1,38 @@
+//
+// Created by Brett on 10/16/2026.
+// Bot-only simulation: many tables play concurrently as coroutines on a single TableScheduler.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_SIMULATION_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_SIMULATION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "GameConfig.hpp"
+
+class EventLog;
+class ColumnarWriter;
+
+struct SimulationOptions {
+  std::uint64_t games = 1000;
+  int tables = 100;   // Tables in play at the same time
+  int players = 4;    // Seats per table
+  std::chrono::microseconds thinkTime{0};  // Average bot think-time per decision
+  std::uint32_t seed = 1;  // Of the dice and the bots; runs without think-time repeat exactly
+  std::shared_ptr<const GameConfig> config = DefaultGameConfig();
+};
+
+struct SimulationResult {
+  std::uint64_t games = 0;
+  std::chrono::duration<double> elapsed{};
+};
+
+// Plays options.games games on the calling thread, optionally logging every game and exporting
+// every outcome
+SimulationResult Simulate(const SimulationOptions& options, EventLog* event_log, ColumnarWriter* columns);
+
+// Prints a summary and returns the process exit code for 'LiarsDice --simulate'
+int RunSimulation(const SimulationOptions& options, EventLog* event_log, ColumnarWriter* columns);
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_SIMULATION_HPP
@@ -0,0 +1,137 @@
+//
+// Created by Brett on 10/16/2026.
+// Slab storage for tables, addressed through generation-checked handles.
+//
+// Tables live in fixed-size slabs that never move, so a running game coroutine can keep referring
+// to its Game. A destroyed table is not destructed: its slot goes on a free list with its object
+// intact and is handed out again by the next Create, so a recycled Game keeps its players and dice
+// and creating or destroying a table is O(1) without touching the allocator once warmed up.
+// Every slot carries a generation that changes on Create and Destroy; a handle to a destroyed table
+// no longer resolves, even after its slot has been reused.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_TABLEMANAGER_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_TABLEMANAGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "Game.hpp"
+
+struct TableHandle {
+  static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t index = kInvalidIndex;
+  std::uint32_t generation = 0;
+
+  bool operator==(const TableHandle&) const = default;
+  [[nodiscard]] bool IsValid() const { return index != kInvalidIndex; }
+};
+
+template <typename Table = Game>
+class TableManager {
+public:
+  static constexpr std::uint32_t kSlabSize = 4096;  // Tables per slab; a power of two
+
+  TableManager() = default;
+  TableManager(const TableManager&) = delete;
+  TableManager& operator=(const TableManager&) = delete;
+
+  // Returns a free table, recycled if possible. A recycled table still holds the state it was
+  // destroyed with; the caller resets what it needs (e.g. Game::ResetTable).
+  TableHandle Create() {
+    if (freeHead == kEndOfList) {
+      addSlab();
+    }
+    std::uint32_t index = freeHead;
+    Slot& slot = slotAt(index);
+    freeHead = slot.nextFree;
+    ++slot.generation;  // Odd: in use
+    ++live;
+    return {index, slot.generation};
+  }
+
+  // Returns the table to the free list; stale handles are ignored
+  void Destroy(TableHandle handle) {
+    Slot* slot = find(handle);
+    if (slot == nullptr) {
+      return;
+    }
+    ++slot->generation;  // Even: free
+    slot->nextFree = freeHead;
+    freeHead = handle.index;
+    --live;
+  }
+
+  // The table behind 'handle', or nullptr if it has been destroyed
+  Table* Get(TableHandle handle) {
+    Slot* slot = find(handle);
+    return slot != nullptr ? &slot->table : nullptr;
+  }
+
+  // The handle of the table in use at 'index', or an invalid handle
+  TableHandle HandleAt(std::uint32_t index) {
+    if (index >= Capacity() || slotAt(index).generation % 2 == 0) {
+      return {};
+    }
+    return {index, slotAt(index).generation};
+  }
+
+  // Grows the storage so that 'tables' tables exist without further allocation
+  void Reserve(std::size_t tables) {
+    while (Capacity() < tables) {
+      addSlab();
+    }
+  }
+
+  [[nodiscard]] std::size_t Size() const { return live; }
+  [[nodiscard]] std::size_t Capacity() const { return slabs.size() * kSlabSize; }
+
+  // Calls fn(handle, table) for every table in use
+  template <typename Fn>
+  void ForEach(Fn&& fn) {
+    for (std::uint32_t index = 0; index < Capacity(); ++index) {
+      Slot& slot = slotAt(index);
+      if (slot.generation % 2 == 1) {
+        fn(TableHandle{index, slot.generation}, slot.table);
+      }
+    }
+  }
+
+private:
+  static constexpr std::uint32_t kEndOfList = TableHandle::kInvalidIndex;
+
+  struct Slot {
+    Table table;
+    std::uint32_t generation = 0;  // Odd while the table is in use
+    std::uint32_t nextFree = kEndOfList;
+  };
+
+  std::vector<std::unique_ptr<Slot[]>> slabs;
+  std::uint32_t freeHead = kEndOfList;
+  std::size_t live = 0;
+
+  Slot& slotAt(std::uint32_t index) { return slabs[index / kSlabSize][index % kSlabSize]; }
+
+  Slot* find(TableHandle handle) {
+    if (handle.index >= Capacity()) {
+      return nullptr;
+    }
+    Slot& slot = slotAt(handle.index);
+    return slot.generation == handle.generation && slot.generation % 2 == 1 ? &slot : nullptr;
+  }
+
+  // Threads the new slab onto the free list so that lower indices are handed out first
+  void addSlab() {
+    auto first = static_cast<std::uint32_t>(Capacity());
+    auto& slab = slabs.emplace_back(std::make_unique<Slot[]>(kSlabSize));
+    for (std::uint32_t i = kSlabSize; i-- > 0;) {
+      slab[i].nextFree = freeHead;
+      freeHead = first + i;
+    }
+  }
+};
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_TABLEMANAGER_HPP
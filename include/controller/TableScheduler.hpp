@@ -0,0 +1,115 @@
+//
+// Created by Brett on 10/16/2026.
+// Single-threaded scheduler that interleaves many coroutine game loops (GameTask) on one thread.
+// A table that waits on a player decision is simply a suspended coroutine; it costs no thread and
+// is resumed once the decision arrives, either right away or at a given time (bot think-time).
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_TABLESCHEDULER_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_TABLESCHEDULER_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+class TableScheduler;
+
+// Coroutine type of a game loop run by a TableScheduler
+class GameTask {
+public:
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+    void await_suspend(Handle handle) noexcept;
+    void await_resume() noexcept {}
+  };
+
+  struct promise_type {
+    TableScheduler* scheduler = nullptr;
+    std::function<void()> onFinished;
+    std::exception_ptr exception;
+
+    GameTask get_return_object() { return GameTask(Handle::from_promise(*this)); }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { exception = std::current_exception(); }
+  };
+
+  GameTask(GameTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+  GameTask& operator=(GameTask&&) = delete;
+  ~GameTask() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  // Hands the coroutine frame over to whoever runs it
+  Handle Release() { return std::exchange(handle, {}); }
+
+private:
+  explicit GameTask(Handle handle) : handle(handle) {}
+  Handle handle;
+};
+
+class TableScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Starts running 'task'; 'on_finished' is called once it completes and may spawn further tasks
+  void Spawn(GameTask task, std::function<void()> on_finished = {});
+
+  // Queues a suspended coroutine to be resumed on the next pass
+  void Post(std::coroutine_handle<> handle) { ready.push_back(handle); }
+
+  // Queues a suspended coroutine to be resumed once 'when' has passed
+  void PostAt(Clock::time_point when, std::coroutine_handle<> handle);
+
+  // Runs until every spawned task has finished. Rethrows the first exception a task ended with.
+  void Run();
+
+  // Resumes everything that is ready or due without blocking
+  void RunReady();
+
+  // Deadline of the earliest pending timer, for callers that block in their own event loop
+  [[nodiscard]] std::optional<Clock::time_point> NextDeadline() const;
+
+  [[nodiscard]] std::size_t ActiveTasks() const { return activeTasks; }
+
+private:
+  friend struct GameTask::FinalAwaiter;
+
+  struct Timer {
+    Clock::time_point when;
+    std::uint64_t sequence;  // Keeps timers with the same deadline in posting order
+    std::coroutine_handle<> handle;
+
+    bool operator>(const Timer& other) const {
+      return when != other.when ? when > other.when : sequence > other.sequence;
+    }
+  };
+
+  std::deque<std::coroutine_handle<>> ready;
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers;
+  std::uint64_t timerSequence = 0;
+  std::size_t activeTasks = 0;
+  std::exception_ptr firstError;
+
+  void finish(GameTask::Handle handle) noexcept;
+};
+
+inline void GameTask::FinalAwaiter::await_suspend(Handle handle) noexcept {
+  handle.promise().scheduler->finish(handle);
+}
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_TABLESCHEDULER_HPP
@@ -0,0 +1,206 @@
+//
+// Created by Brett on 10/16/2026.
+// Hierarchical timer wheel for large numbers of coarse deadlines, such as one turn limit per seat
+// across every table of a server loop.
+//
+// Time is counted in ticks. Four levels of 256 slots cover 256, 256^2, 256^3 and 256^4 ticks
+// ahead; a timer sits in the slot of the coarsest level its distance needs and is moved down a
+// level each time the level below wraps around, so it is touched at most once per level. Timers
+// are pooled nodes on intrusive doubly linked lists: arming and cancelling are O(1) and allocate
+// nothing once the pool is warm. A TimerId carries a generation, so cancelling a timer that has
+// already fired (and whose node may have been reused) does nothing.
+//
+
+#ifndef LIARSDICE_INCLUDE_CONTROLLER_TIMERWHEEL_HPP
+#define LIARSDICE_INCLUDE_CONTROLLER_TIMERWHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+struct TimerId {
+  static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t index = kInvalidIndex;
+  std::uint32_t generation = 0;
+
+  bool operator==(const TimerId&) const = default;
+  [[nodiscard]] bool IsValid() const { return index != kInvalidIndex; }
+};
+
+template <typename Payload>
+class TimerWheel {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 8;
+  static constexpr std::uint32_t kSlots = 1u << kSlotBits;
+
+  explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(10), Clock::time_point start = Clock::now())
+      : tick(tick), start(start) {
+    for (auto& level : slots) {
+      level.fill(kNone);
+    }
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Fires 'payload' once 'delay' has passed, rounded up to whole ticks
+  TimerId Arm(Clock::duration delay, Payload payload) {
+    auto ticks = static_cast<std::uint64_t>(std::max<Clock::rep>((delay + tick - Clock::duration(1)) / tick, 1));
+    std::uint32_t index = allocate();
+    Node& node = nodes[index];
+    node.payload = std::move(payload);
+    node.expiry = now + std::min(ticks, kMaxTicks);
+    ++node.generation;  // Odd: armed
+    link(index);
+    ++armed;
+    return {index, node.generation};
+  }
+
+  // Stops a pending timer; returns false if it already fired or was cancelled
+  bool Cancel(TimerId id) {
+    if (!id.IsValid() || id.index >= nodes.size() || nodes[id.index].generation != id.generation ||
+        id.generation % 2 == 0) {
+      return false;
+    }
+    unlink(id.index);
+    release(id.index);
+    return true;
+  }
+
+  // Moves the wheel up to 'time' and calls fire(payload) for every timer that came due, one tick
+  // after another. 'fire' may arm and cancel timers.
+  template <typename Fire>
+  void Advance(Clock::time_point time, Fire&& fire) {
+    std::uint64_t target = time <= start ? 0 : static_cast<std::uint64_t>((time - start) / tick);
+    if (armed == 0) {
+      now = std::max(now, target);
+      return;
+    }
+    while (now < target) {
+      ++now;
+      // Bring the timers of the coarser levels down as the finer ones wrap
+      for (int level = 1; level < kLevels && (now & levelMask(level - 1)) == 0; ++level) {
+        cascade(level, slotOf(now, level));
+      }
+      std::uint32_t& head = slots[0][now & (kSlots - 1)];
+      while (head != kNone) {
+        std::uint32_t index = head;
+        unlink(index);
+        Payload payload = std::move(nodes[index].payload);
+        release(index);
+        fire(payload);
+      }
+    }
+  }
+
+  // When the next timer may fire, for callers that block in their own event loop. Exact within
+  // 256 ticks; further out it is the next time the first level wraps.
+  [[nodiscard]] std::optional<Clock::time_point> NextDeadline() const {
+    if (armed == 0) {
+      return std::nullopt;
+    }
+    std::uint64_t next = now + 1;
+    while (slots[0][next & (kSlots - 1)] == kNone && (next & (kSlots - 1)) != 0) {
+      ++next;
+    }
+    return start + tick * static_cast<Clock::rep>(next);
+  }
+
+  [[nodiscard]] std::size_t Size() const { return armed; }
+
+private:
+  static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint64_t kMaxTicks = (std::uint64_t{1} << (kLevels * kSlotBits)) - 1;
+
+  struct Node {
+    Payload payload{};
+    std::uint64_t expiry = 0;  // In ticks since 'start'
+    std::uint32_t prev = kNone;
+    std::uint32_t next = kNone;
+    std::uint32_t* head = nullptr;  // The slot list the node is on
+    std::uint32_t generation = 0;   // Odd while armed
+  };
+
+  Clock::duration tick;
+  Clock::time_point start;
+  std::uint64_t now = 0;  // Ticks processed so far
+  std::array<std::array<std::uint32_t, kSlots>, kLevels> slots{};
+  std::vector<Node> nodes;
+  std::uint32_t freeHead = kNone;
+  std::size_t armed = 0;
+
+  static constexpr std::uint64_t levelMask(int level) {
+    return (std::uint64_t{1} << ((level + 1) * kSlotBits)) - 1;
+  }
+
+  static constexpr std::uint32_t slotOf(std::uint64_t ticks, int level) {
+    return static_cast<std::uint32_t>(ticks >> (level * kSlotBits)) & (kSlots - 1);
+  }
+
+  std::uint32_t allocate() {
+    if (freeHead == kNone) {
+      nodes.emplace_back();
+      return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+    return std::exchange(freeHead, nodes[freeHead].next);
+  }
+
+  void release(std::uint32_t index) {
+    Node& node = nodes[index];
+    ++node.generation;  // Even: free
+    node.next = freeHead;
+    freeHead = index;
+    --armed;
+  }
+
+  // Files the node under the coarsest level its distance from 'now' needs
+  void link(std::uint32_t index) {
+    Node& node = nodes[index];
+    std::uint64_t distance = node.expiry - now;
+    int level = 0;
+    while (level < kLevels - 1 && distance > levelMask(level)) {
+      ++level;
+    }
+    std::uint32_t& head = slots[level][slotOf(node.expiry, level)];
+    node.head = &head;
+    node.prev = kNone;
+    node.next = head;
+    if (head != kNone) {
+      nodes[head].prev = index;
+    }
+    head = index;
+  }
+
+  void unlink(std::uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != kNone) {
+      nodes[node.prev].next = node.next;
+    } else {
+      *node.head = node.next;
+    }
+    if (node.next != kNone) {
+      nodes[node.next].prev = node.prev;
+    }
+  }
+
+  void cascade(int level, std::uint32_t slot) {
+    std::uint32_t index = std::exchange(slots[level][slot], kNone);
+    while (index != kNone) {
+      std::uint32_t next = nodes[index].next;
+      link(index);
+      index = next;
+    }
+  }
+};
+
+#endif //LIARSDICE_INCLUDE_CONTROLLER_TIMERWHEEL_HPP
@@ -0,0 +1,69 @@
+//
+// Created by Brett on 10/16/2026.
+// Hardware performance counters per turn phase, read through Linux perf_event_open: cycles,
+// instructions, cache references and misses, branches and branch mispredictions.
+//
+// Built only with the LIARSDICE_PERF_COUNTERS CMake option (Linux). Every TRACE_SPAN (see
+// Trace.hpp) then reads its thread's counter group when it opens and closes and adds the difference
+// to its phase. Counts are user-space only and include nested spans. Each read is a system call, so
+// a counted run is slower; the kernel's side of that call is not counted. Where the counters cannot
+// be opened (no PMU in a virtual machine, perf_event_paranoid too strict) spans count nothing and
+// the report says why.
+//
+
+#ifndef LIARSDICE_INCLUDE_DIAGNOSTICS_PERFCOUNTERS_HPP
+#define LIARSDICE_INCLUDE_DIAGNOSTICS_PERFCOUNTERS_HPP
+
+#ifdef LIARSDICE_PERF_COUNTERS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "TracePhase.hpp"
+
+enum class PerfCounter : std::uint8_t {
+  Cycles,
+  Instructions,
+  CacheReferences,
+  CacheMisses,
+  Branches,
+  BranchMisses,
+};
+
+inline constexpr std::size_t kPerfCounterCount = 6;
+
+using PerfCounterValues = std::array<std::uint64_t, kPerfCounterCount>;
+
+// Reads the calling thread's counters, opening them on first use; false if they are unavailable
+bool ReadPerfCounters(PerfCounterValues& values);
+
+// Adds the counts between 'start' and 'end' to the calling thread's totals for 'phase'
+void AddPhaseCounts(TracePhase phase, const PerfCounterValues& start, const PerfCounterValues& end);
+
+class PhaseCounterSpan {
+public:
+  explicit PhaseCounterSpan(TracePhase phase) : phase(phase), counting(ReadPerfCounters(start)) {}
+
+  ~PhaseCounterSpan() {
+    PerfCounterValues end;
+    if (counting && ReadPerfCounters(end)) {
+      AddPhaseCounts(phase, start, end);
+    }
+  }
+
+  PhaseCounterSpan(const PhaseCounterSpan&) = delete;
+  PhaseCounterSpan& operator=(const PhaseCounterSpan&) = delete;
+
+private:
+  TracePhase phase;
+  PerfCounterValues start;
+  bool counting;
+};
+
+// Prints every phase's counts summed over all threads, with IPC and miss rates
+void WritePhaseCounters(std::ostream& out);
+
+#endif
+
+#endif //LIARSDICE_INCLUDE_DIAGNOSTICS_PERFCOUNTERS_HPP
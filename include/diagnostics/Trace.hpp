@@ -0,0 +1,107 @@
+//
+// Created by Brett on 10/16/2026.
+// Scoped trace spans around the phases of a turn (render, input, validate, resolve, roll), for
+// viewing in Perfetto or chrome://tracing.
+//
+// Built only with the LIARSDICE_TRACING CMake option; LIARSDICE_PERF_COUNTERS makes TRACE_SPAN
+// count the phase as well (see PerfCounters.hpp). With neither, TRACE_SPAN expands to nothing and
+// no code or data is left behind. A span reads the CPU's time-stamp counter when it opens and
+// closes and stores one 24-byte event in its thread's ring buffer, which keeps the most recent
+// kTraceBufferEvents spans. WriteTrace converts every thread's buffer to Chrome trace-event JSON.
+// It may run while other threads record; a span that lands during the dump may be left out.
+//
+
+#ifndef LIARSDICE_INCLUDE_DIAGNOSTICS_TRACE_HPP
+#define LIARSDICE_INCLUDE_DIAGNOSTICS_TRACE_HPP
+
+#include "TracePhase.hpp"
+
+#ifdef LIARSDICE_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+struct TraceEvent {
+  std::uint64_t start;  // Ticks, see ReadTraceTicks
+  std::uint64_t end;
+  TracePhase phase;
+};
+
+inline constexpr std::size_t kTraceBufferEvents = 1 << 16;  // Per thread; a power of two
+
+struct TraceBuffer {
+  std::unique_ptr<TraceEvent[]> events = std::make_unique<TraceEvent[]>(kTraceBufferEvents);
+  std::atomic<std::uint64_t> written{0};  // Events ever recorded; the ring holds the last ones
+  int threadId = 0;
+};
+
+// The time-stamp counter where there is one, nanoseconds of the steady clock elsewhere
+inline std::uint64_t ReadTraceTicks() {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Creates the calling thread's buffer and registers it for WriteTrace
+TraceBuffer* RegisterTraceBuffer();
+
+inline void RecordTraceSpan(TracePhase phase, std::uint64_t start, std::uint64_t end) {
+  thread_local TraceBuffer* buffer = RegisterTraceBuffer();
+  std::uint64_t index = buffer->written.load(std::memory_order_relaxed);
+  buffer->events[index & (kTraceBufferEvents - 1)] = {start, end, phase};
+  buffer->written.store(index + 1, std::memory_order_release);
+}
+
+class TraceSpan {
+public:
+  explicit TraceSpan(TracePhase phase) : phase(phase), start(ReadTraceTicks()) {}
+  ~TraceSpan() { RecordTraceSpan(phase, start, ReadTraceTicks()); }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  TracePhase phase;
+  std::uint64_t start;
+};
+
+// Writes the recorded spans of every thread as Chrome trace-event JSON
+void WriteTrace(std::ostream& out);
+
+// The same into a file; throws FileException if it cannot be written
+void WriteTraceFile(const std::string& path);
+
+#endif
+
+#ifdef LIARSDICE_PERF_COUNTERS
+#include "PerfCounters.hpp"
+#endif
+
+#define LIARSDICE_TRACE_CONCAT_(a, b) a##b
+#define LIARSDICE_TRACE_NAME_(prefix, line) LIARSDICE_TRACE_CONCAT_(prefix, line)
+
+// Traces and/or counts the rest of the enclosing scope as the given TracePhase
+#if defined(LIARSDICE_TRACING) && defined(LIARSDICE_PERF_COUNTERS)
+#define TRACE_SPAN(phase)                                                          \
+  TraceSpan LIARSDICE_TRACE_NAME_(traceSpan, __LINE__)(TracePhase::phase);         \
+  PhaseCounterSpan LIARSDICE_TRACE_NAME_(counterSpan, __LINE__)(TracePhase::phase)
+#elif defined(LIARSDICE_TRACING)
+#define TRACE_SPAN(phase) TraceSpan LIARSDICE_TRACE_NAME_(traceSpan, __LINE__)(TracePhase::phase)
+#elif defined(LIARSDICE_PERF_COUNTERS)
+#define TRACE_SPAN(phase) PhaseCounterSpan LIARSDICE_TRACE_NAME_(counterSpan, __LINE__)(TracePhase::phase)
+#else
+#define TRACE_SPAN(phase) static_cast<void>(0)
+#endif
+
+#endif //LIARSDICE_INCLUDE_DIAGNOSTICS_TRACE_HPP
@@ -0,0 +1,23 @@
+//
+// Created by Brett on 10/16/2026.
+// The phases of a turn measured by TRACE_SPAN (see Trace.hpp and PerfCounters.hpp).
+//
+
+#ifndef LIARSDICE_INCLUDE_DIAGNOSTICS_TRACEPHASE_HPP
+#define LIARSDICE_INCLUDE_DIAGNOSTICS_TRACEPHASE_HPP
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+enum class TracePhase : std::uint8_t {
+  Render,
+  Input,
+  Validate,
+  Resolve,
+  Roll,
+};
+
+inline constexpr std::array<std::string_view, 5> kTracePhaseNames = {"render", "input", "validate", "resolve", "roll"};
+
+#endif //LIARSDICE_INCLUDE_DIAGNOSTICS_TRACEPHASE_HPP
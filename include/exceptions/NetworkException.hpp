@@ -0,0 +1,15 @@
+//
+// Created by Brett on 10/16/2026.
+//
+
+#ifndef LIARSDICE_INCLUDE_EXCEPTIONS_NETWORKEXCEPTION_HPP
+#define LIARSDICE_INCLUDE_EXCEPTIONS_NETWORKEXCEPTION_HPP
+
+#include "CustomException.hpp"
+
+class NetworkException : public CustomException {
+public:
+  explicit NetworkException(const std::string& message) : CustomException("Network Error: " + message) {}
+};
+
+#endif //LIARSDICE_INCLUDE_EXCEPTIONS_NETWORKEXCEPTION_HPP
@@ -0,0 +1,22 @@
+//
+// Created by Brett on 10/16/2026.
+// Allocation-free parser for typed bids.
+//
+// Accepted forms, case-insensitive, surrounding blanks ignored:
+//   "3,4"  "3, 4"  "3 4"  "3 fours"  "three fours"  "two 6"  "one six"
+// The count and the face may each be digits or an English word; the face word may be singular or
+// plural ("six", "sixes"). Digits are read with std::from_chars, so no locale is consulted.
+//
+
+#ifndef LIARSDICE_INCLUDE_INPUT_BIDPARSER_HPP
+#define LIARSDICE_INCLUDE_INPUT_BIDPARSER_HPP
+
+#include <optional>
+#include <string_view>
+#include <utility>
+
+// Returns {quantity, face_value}, or nothing if 'text' is not a bid or names a count or face below
+// one. Whether the bid is legal is left to Game::ValidateGuess.
+std::optional<std::pair<int, int>> ParseBid(std::string_view text);
+
+#endif //LIARSDICE_INCLUDE_INPUT_BIDPARSER_HPP
@@ -0,0 +1,95 @@
+//
+// Created by Brett on 10/16/2026.
+// Where the console game gets its answers from. ConsoleReader is the player at the terminal: it
+// shows each prompt and flushes the output before waiting. ScriptReader reads the same answers from
+// a file or pipe and shows nothing, and a game reading from it draws no prompts or screens, so a
+// script of setup answers, bids and liar calls runs the interactive code path at full speed.
+//
+// A script holds one answer per line, exactly as a player would type it: the number of players, then
+// for every turn a bid and a liar call ("yes", "no", "spot"), and "yes" or "no" after each game. An
+// empty line is an answer too (a liar call that passes); lines starting with '#' are comments.
+//
+
+#ifndef LIARSDICE_INCLUDE_INPUT_LINEREADER_HPP
+#define LIARSDICE_INCLUDE_INPUT_LINEREADER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+enum class ReadStatus {
+  Line,      // An answer was read
+  TimedOut,  // The deadline passed first
+  End,       // There is no more input
+};
+
+class LineReader {
+public:
+  using Clock = std::chrono::steady_clock;
+  static constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
+
+  virtual ~LineReader() = default;
+
+  // Shows 'prompt' if a player is watching, then reads the next answer into 'line' without its line
+  // break, waiting no later than 'deadline'
+  virtual ReadStatus ReadLine(std::string_view prompt, std::string& line, Clock::time_point deadline = kNoDeadline) = 0;
+
+  // False when nobody is watching: the game skips its prompts and screen redraws
+  [[nodiscard]] virtual bool Interactive() const = 0;
+};
+
+// Reads the player's answers from standard input. The reader polls the descriptor and only reads
+// what is ready, so it can give up at a deadline and run background work while the player thinks.
+// Answers typed after a deadline has passed are discarded. (On Windows it reads std::cin and has
+// neither deadlines nor idle work.)
+class ConsoleReader final : public LineReader {
+public:
+  static constexpr int kStandardInput = 0;
+
+  explicit ConsoleReader(int fd = kStandardInput) : fd(fd) {}
+
+  ReadStatus ReadLine(std::string_view prompt, std::string& line, Clock::time_point deadline = kNoDeadline) override;
+  [[nodiscard]] bool Interactive() const override { return true; }
+
+  // Runs 'hook' every 'interval' while waiting for the player, e.g. to save progress
+  void SetIdleHook(std::function<void()> hook, std::chrono::milliseconds interval) {
+    idleHook = std::move(hook);
+    idleInterval = interval;
+  }
+
+private:
+  int fd;
+  std::string buffer;         // Read from the descriptor, not yet returned
+  std::size_t consumed = 0;   // Start of the first line not yet returned
+  bool ended = false;
+  std::function<void()> idleHook;
+  std::chrono::milliseconds idleInterval{0};
+
+  bool takeLine(std::string& line);
+  void readAvailable();
+};
+
+// The reader console games use unless given another
+ConsoleReader& ConsoleInput();
+
+// Reads answers from a script; never times out
+class ScriptReader final : public LineReader {
+public:
+  // Opens the script at 'path', or reads standard input for "-". Throws FileException if the file
+  // cannot be opened.
+  explicit ScriptReader(const std::string& path);
+
+  ReadStatus ReadLine(std::string_view prompt, std::string& line, Clock::time_point deadline = kNoDeadline) override;
+  [[nodiscard]] bool Interactive() const override { return false; }
+
+private:
+  std::ifstream file;
+  std::istream* script;
+};
+
+#endif //LIARSDICE_INCLUDE_INPUT_LINEREADER_HPP
@@ -0,0 +1,17 @@
+//
+// Created by Brett on 10/16/2026.
+// Odds of a bid being true, as seen by a player who only knows their own dice.
+//
+
+#ifndef LIARSDICE_INCLUDE_MODEL_BIDPROBABILITY_HPP
+#define LIARSDICE_INCLUDE_MODEL_BIDPROBABILITY_HPP
+
+// Chance that one fair die counts toward 'face': 2 in 'faces' for faces other than one when ones
+// are wild, otherwise 1 in 'faces'
+double MatchChance(int face, int faces, bool ones_wild);
+
+// Probability that at least 'needed' of 'unknown_dice' unseen dice count toward a face, each with
+// probability 'chance' (see MatchChance)
+double ProbabilityAtLeast(int needed, int unknown_dice, double chance);
+
+#endif //LIARSDICE_INCLUDE_MODEL_BIDPROBABILITY_HPP
@@ -6,24 +6,34 @@
 #ifndef DICE_HPP
 #define DICE_HPP
 
+#include <cstdint>
 #include <random>
 
 class Dice {
 public:
-  // Constructor initializes the random number generator
-  Dice();
+  static constexpr unsigned int kDefaultFaces = 6;
 
-  // Rolls the dice and updates the face value
-  void Roll();
+  // A new die shows no face until it is first rolled (Player rolls all of its dice on construction)
+  Dice() = default;
+
+  // Rolls the dice and updates the face value to one of 1..faces
+  void Roll(unsigned int faces = kDefaultFaces);
 
   // Returns the current face value of the dice
   [[nodiscard]] unsigned int GetFaceValue() const;
 
+  // Forces the face value, e.g. when re-simulating a recorded game
+  void SetFaceValue(unsigned int value) { face_value = value; }
+
+  // Reseeds the calling thread's generator so the rolls that follow repeat from run to run
+  static void Seed(std::uint32_t seed) { Generator().seed(seed); }
+
 private:
   unsigned int face_value{};  // Holds the face value of the dice
-  std::random_device rd;  // Random device engine
-  std::mt19937 gen;  // Mersenne Twister random number generator
-  std::uniform_int_distribution<> dis;  // Uniform distribution
+
+  // Mersenne Twister shared by all dice of the calling thread, seeded once from std::random_device.
+  // Keeping the generator out of the die keeps a die at four bytes and makes it cheap to create.
+  static std::mt19937& Generator();
 };
 
 #endif // DICE_HPP
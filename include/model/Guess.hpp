@@ -0,0 +1,37 @@
+//
+// Created by Brett on 10/16/2026.
+// A bid of "diceCount dice showing diceValue", and the ways the next player can answer it.
+//
+
+#ifndef LIARSDICE_INCLUDE_MODEL_GUESS_HPP
+#define LIARSDICE_INCLUDE_MODEL_GUESS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// Struct to represent a guess
+struct Guess {
+  int diceValue;
+  int diceCount;
+
+  // Convert pair<int, int> into Guess
+  explicit Guess(std::pair<int, int> guess_pair) {
+    diceCount = guess_pair.first;
+    diceValue = guess_pair.second;
+  }
+};
+
+// The smallest raise that is always valid, e.g. the move made for a player who ran out of time
+inline std::pair<int, int> MinimumRaise(const Guess& last_guess) {
+  return {last_guess.diceCount + 1, std::max(last_guess.diceValue, 1)};
+}
+
+// Answer to the standing bid. The values are part of the network protocol.
+enum class CallType : std::uint8_t {
+  Pass = 0,    // Let the bidding continue
+  Liar = 1,    // The bid is too high
+  SpotOn = 2,  // The bid is exactly right; only with RuleVariant::spotOn
+};
+
+#endif //LIARSDICE_INCLUDE_MODEL_GUESS_HPP
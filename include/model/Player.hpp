@@ -6,34 +6,56 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 #include "Dice.hpp"
+#include "Guess.hpp"
+
+class LineReader;
+class TerminalRenderer;
 
 class Player {
 public:
-  // Constructor initializes the player with an ID
-  explicit Player(int id);
+  static constexpr int kDefaultDiceCount = 5;
+  static constexpr std::string_view kGuessPrompt = "Enter your guess in format (quantity, face_value): ";
+
+  // When a decision is due, as taken by LineReader::ReadLine
+  using Deadline = std::chrono::steady_clock::time_point;
+  static constexpr Deadline kNoDeadline = Deadline::max();
+
+  // Constructor initializes the player with an ID and dice_count dice of the given number of faces
+  explicit Player(int id, int dice_count = kDefaultDiceCount, unsigned int faces = Dice::kDefaultFaces);
 
   // Rolls all the dice for the player
   void RollDice();
 
-  // Displays the face values of the player's dice
-  void DisplayDice();
+  // Adds the face values of the player's dice to the frame being drawn
+  void DisplayDice(TerminalRenderer& screen) const;
 
-  // Allows the player to make a guess
-  std::pair<int, int> MakeGuess();
+  // Allows the player to make a guess; 'prompted' means kGuessPrompt is already on screen. Returns
+  // nothing if the deadline passes first and throws InputException if the input ends first.
+  std::optional<std::pair<int, int>> MakeGuess(LineReader& input, bool prompted = false, Deadline deadline = kNoDeadline);
 
-  // Allows the player to call "Liar" on another player's guess
-  bool CallLiar();
+  // Allows the player to call "Liar" on another player's guess, or "spot on" if the rules allow it.
+  // Returns nothing if the deadline passes first and throws InputException if the input ends first.
+  std::optional<CallType> CallLiar(LineReader& input, bool allow_spot_on = false, Deadline deadline = kNoDeadline);
 
   // Returns a const reference to the player's dice to avoid copying
   [[nodiscard]] const std::vector<Dice>& GetDice() const { return dice; }
 
   [[nodiscard]] int GetPlayerId() const { return id; };
 
+  // Replaces the player's dice with the given face values; throws GameLogicException if one is outside 1..faces
+  void SetDice(std::span<const std::uint8_t> face_values);
+
 private:
   int id;  // Player ID
   std::vector<Dice> dice;  // Player's dice
+  unsigned int faces;  // Faces of every die
 };
 
 #endif //PLAYER_HPP
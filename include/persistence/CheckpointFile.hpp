@@ -0,0 +1,74 @@
+//
+// Created by Brett on 10/16/2026.
+// Memory-mapped file of fixed-size records that survives a crash of the writer at any point.
+//
+// Every record index owns two slots, A and B. A write goes to the slot holding the older copy and
+// is stamped with a sequence number and a CRC-32, so a write torn by a crash fails its checksum
+// and the previous copy in the other slot is used instead. Writing is a memcpy into the mapping:
+// the kernel carries the pages to disk on its own, and Sync (safe from another thread) forces
+// them out for machine crashes as well.
+//
+// Layout: a 64-byte header ("LDCKPT01", u32 record size), then for record i the slots 2i and 2i+1,
+// each a u32 CRC of the rest of the slot, u32 payload length (0 = cleared), u64 sequence, payload.
+//
+
+#ifndef LIARSDICE_INCLUDE_PERSISTENCE_CHECKPOINTFILE_HPP
+#define LIARSDICE_INCLUDE_PERSISTENCE_CHECKPOINTFILE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CheckpointFile {
+public:
+  static constexpr std::size_t kSlotHeaderSize = 16;
+
+  // Opens or creates the file with room for records of up to 'record_size' bytes and at most
+  // 'max_records' indices; throws FileException
+  CheckpointFile(const std::string& filename, std::size_t record_size, std::uint32_t max_records);
+  ~CheckpointFile();
+
+  CheckpointFile(const CheckpointFile&) = delete;
+  CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+  // Copies of the newest intact live record of every index, as left by a previous writer. An
+  // existing file written with another record size is read with its own size.
+  [[nodiscard]] std::vector<std::pair<std::uint32_t, std::vector<std::uint8_t>>> ReadAll() const;
+
+  // Drops every record and adopts this file's record size
+  void Reset();
+
+  // Replaces the record at 'index'; returns false if it does not fit. The first write to a file
+  // left with another record size resets it.
+  bool Write(std::uint32_t index, std::span<const std::uint8_t> record);
+
+  // Marks the record at 'index' as gone
+  void Clear(std::uint32_t index);
+
+  // Flushes written pages to disk; may run on another thread than the writer
+  void Sync() const;
+
+  [[nodiscard]] std::size_t RecordSize() const { return recordSize; }
+
+private:
+  int fd = -1;
+  std::string filename;
+  std::size_t recordSize;      // Payload bytes per slot
+  std::size_t fileRecordSize;  // The record size the file was written with
+  std::uint32_t maxRecords;
+  std::uint8_t* mapping = nullptr;
+  std::size_t mappingSize = 0;
+  std::atomic<std::size_t> fileSize{0};
+
+  [[nodiscard]] std::size_t slotSize(std::size_t record_size) const { return kSlotHeaderSize + record_size; }
+  std::uint8_t* slot(std::uint32_t index, int which) const;
+  void writeHeader();
+  void grow(std::uint32_t index);
+  void stamp(std::uint32_t index, std::span<const std::uint8_t> record, bool live);
+};
+
+#endif //LIARSDICE_INCLUDE_PERSISTENCE_CHECKPOINTFILE_HPP
@@ -0,0 +1,91 @@
+//
+// Created by Brett on 10/16/2026.
+// Columnar binary export of game outcomes.
+//
+// An export is a directory holding one file per column plus a small schema file:
+//   schema      : kColumnStoreMagic, u64 row count, u32 column count,
+//                 then per column: u8 name length, name, u8 value width in bytes
+//   <name>.col  : chunks of up to kChunkRows values, each
+//                 u8 ColumnEncoding, u32 row count, u32 payload size, payload
+// Every chunk is stored with whichever encoding makes it smallest, so a reader only ever touches
+// the files of the columns it asks for and never parses text.
+//
+
+#ifndef LIARSDICE_INCLUDE_PERSISTENCE_COLUMNSTORE_HPP
+#define LIARSDICE_INCLUDE_PERSISTENCE_COLUMNSTORE_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Game.hpp"
+
+inline constexpr std::array<char, 8> kColumnStoreMagic = {'L', 'D', 'C', 'O', 'L', 'S', 0, 1};
+
+enum class ColumnEncoding : std::uint8_t {
+  Plain = 0,        // Fixed-width little-endian values
+  RunLength = 1,    // (varint value, varint run length) pairs
+  Delta = 2,        // First value, then zig-zag varint differences
+  BitPacked = 3,    // varint minimum, u8 bit width, values minus the minimum packed LSB first
+};
+
+struct ColumnSpec {
+  const char* name;
+  std::uint8_t width;  // Bytes per value when stored plain
+  std::uint64_t (*extract)(const GameOutcome&);
+};
+
+// Columns written for every game outcome, in schema order
+const std::vector<ColumnSpec>& GameOutcomeColumns();
+
+class ColumnarWriter {
+public:
+  static constexpr std::size_t kChunkRows = 64 * 1024;
+
+  // Creates (or empties) the export directory; throws FileException on failure
+  explicit ColumnarWriter(const std::filesystem::path& directory);
+  ~ColumnarWriter();
+
+  ColumnarWriter(const ColumnarWriter&) = delete;
+  ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+  void Append(const GameOutcome& outcome);
+
+  // Writes the pending chunk and the schema; the export is only readable after this
+  void Close();
+
+private:
+  std::filesystem::path directory;
+  std::vector<std::ofstream> files;
+  std::vector<std::vector<std::uint64_t>> pending;  // One buffer per column
+  std::uint64_t rows = 0;
+  bool closed = false;
+
+  void flushChunk();
+};
+
+class ColumnarReader {
+public:
+  struct Column {
+    std::string name;
+    std::uint8_t width;
+  };
+
+  // Reads the schema; throws FileException if the directory is not a column export
+  explicit ColumnarReader(const std::filesystem::path& directory);
+
+  [[nodiscard]] const std::vector<Column>& Columns() const { return columns; }
+  [[nodiscard]] std::uint64_t RowCount() const { return rows; }
+
+  // Decodes a single column without reading any other column file
+  [[nodiscard]] std::vector<std::uint64_t> ReadColumn(const std::string& name) const;
+
+private:
+  std::filesystem::path directory;
+  std::vector<Column> columns;
+  std::uint64_t rows = 0;
+};
+
+#endif //LIARSDICE_INCLUDE_PERSISTENCE_COLUMNSTORE_HPP
@@ -0,0 +1,187 @@
+//
+// Created by Brett on 10/16/2026.
+// Compact, append-only binary log of every game action (rolls, bids, liar calls, resolutions).
+//
+// File layout:
+//   header  : 8 bytes, kEventLogMagic
+//   block*  : u32 payload size, u32 game count, payload
+// A block always starts on a game boundary, so every block can be decoded on its own.
+// Inside a block each event is a one byte EventType followed by LEB128 varints. Player ids are
+// stored as zig-zag deltas from the previous event's player and bid counts as zig-zag deltas from
+// the previous bid of the same game, so a typical event is two to four bytes long.
+//
+
+#ifndef LIARSDICE_INCLUDE_PERSISTENCE_EVENTLOG_HPP
+#define LIARSDICE_INCLUDE_PERSISTENCE_EVENTLOG_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Dice.hpp"
+
+inline constexpr std::array<char, 8> kEventLogMagic = {'L', 'D', 'E', 'V', 'L', 'O', 'G', 1};
+inline constexpr std::size_t kEventLogBlockHeaderSize = 8;
+
+enum class EventType : std::uint8_t {
+  GameStart = 1,    // varint player count
+  Roll = 2,         // zig-zag player delta, varint dice count, varint face per die
+  Bid = 3,          // zig-zag player delta, zig-zag count delta, varint face value
+  RejectedBid = 4,  // same payload as Bid, the guess failed ValidateGuess
+  LiarCall = 5,     // zig-zag player delta
+  Resolution = 6,   // one byte, 0 = guessing player won, 1 = calling player won
+  SpotOnCall = 7,   // zig-zag player delta
+  Rules = 8,        // varint RuleVariant::Index(); follows GameStart, omitted for classic rules
+  Faces = 9,        // varint faces per die; follows GameStart, omitted for six-sided dice
+};
+
+// Shared, thread-safe sink for blocks produced by one or more EventLogWriters
+class EventLog {
+public:
+  explicit EventLog(const std::string& filename);
+
+  // Appends one already encoded block (header included) to the file
+  void AppendBlock(const std::uint8_t* data, std::size_t size);
+
+  void Flush();
+
+private:
+  std::ofstream file;
+  std::mutex fileMutex;
+};
+
+// Per-thread buffer that encodes events and hands them to the EventLog in large blocks.
+// Not thread-safe by design: give every thread (or every simulated table) its own writer.
+class EventLogWriter {
+public:
+  static constexpr std::size_t kDefaultBlockSize = 256 * 1024;
+
+  explicit EventLogWriter(EventLog& log, std::size_t block_size = kDefaultBlockSize);
+  ~EventLogWriter();
+
+  EventLogWriter(const EventLogWriter&) = delete;
+  EventLogWriter& operator=(const EventLogWriter&) = delete;
+
+  // Marks the start of a new game; the only point at which a full block is handed off
+  void BeginGame(int num_players) {
+    if (used - kEventLogBlockHeaderSize >= blockSize) {
+      Flush();
+    }
+    lastPlayerId = 0;
+    lastDiceCount = 0;
+    ++gamesInBlock;
+    gameStart = used;
+    gameOpen = true;
+    std::uint8_t* out = Reserve(1 + kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::GameStart);
+    Commit(PutVarint(out, static_cast<std::uint32_t>(num_players)));
+  }
+
+  void Rules(unsigned variant_index) {
+    std::uint8_t* out = Reserve(1 + kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::Rules);
+    Commit(PutVarint(out, variant_index));
+  }
+
+  void Faces(unsigned faces) {
+    std::uint8_t* out = Reserve(1 + kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::Faces);
+    Commit(PutVarint(out, faces));
+  }
+
+  void Roll(int player_id, const std::vector<Dice>& dice) {
+    std::uint8_t* out = Reserve(1 + 2 * kMaxVarintBytes + dice.size() * kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::Roll);
+    out = PutPlayer(out, player_id);
+    out = PutVarint(out, static_cast<std::uint32_t>(dice.size()));
+    for (const auto& die : dice) {
+      out = PutVarint(out, die.GetFaceValue());
+    }
+    Commit(out);
+  }
+
+  void Bid(int player_id, int dice_count, int dice_value, bool accepted) {
+    std::uint8_t* out = Reserve(1 + 3 * kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(accepted ? EventType::Bid : EventType::RejectedBid);
+    out = PutPlayer(out, player_id);
+    out = PutVarint(out, ZigZag(dice_count - lastDiceCount));
+    out = PutVarint(out, static_cast<std::uint32_t>(dice_value));
+    lastDiceCount = dice_count;
+    Commit(out);
+  }
+
+  void LiarCall(int player_id) {
+    std::uint8_t* out = Reserve(1 + kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::LiarCall);
+    Commit(PutPlayer(out, player_id));
+  }
+
+  void SpotOnCall(int player_id) {
+    std::uint8_t* out = Reserve(1 + kMaxVarintBytes);
+    *out++ = static_cast<std::uint8_t>(EventType::SpotOnCall);
+    Commit(PutPlayer(out, player_id));
+  }
+
+  void Resolution(bool guesser_won) {
+    gameOpen = false;
+    std::uint8_t* out = Reserve(2);
+    *out++ = static_cast<std::uint8_t>(EventType::Resolution);
+    *out++ = guesser_won ? 0 : 1;
+    Commit(out);
+  }
+
+  // Hands the buffered games to the EventLog as one block
+  void Flush();
+
+  // Hands only the games that have ended to the EventLog, keeping the one in progress buffered;
+  // safe in the middle of a game
+  void FlushFinishedGames();
+
+  static constexpr std::size_t kMaxVarintBytes = 5;
+
+  static std::uint32_t ZigZag(int value) {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+  }
+
+  static std::uint8_t* PutVarint(std::uint8_t* out, std::uint32_t value) {
+    while (value >= 0x80) {
+      *out++ = static_cast<std::uint8_t>(value | 0x80);
+      value >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(value);
+    return out;
+  }
+
+private:
+  EventLog& log;
+  std::vector<std::uint8_t> buffer;
+  std::size_t blockSize;
+  std::size_t used = kEventLogBlockHeaderSize;  // The block header is filled in on Flush
+  std::uint32_t gamesInBlock = 0;
+  int lastPlayerId = 0;
+  int lastDiceCount = 0;
+  std::size_t gameStart = kEventLogBlockHeaderSize;  // Offset of the latest game's first event
+  bool gameOpen = false;  // The latest game has not been resolved yet
+
+  std::uint8_t* Reserve(std::size_t bytes) {
+    if (used + bytes > buffer.size()) {
+      Grow(used + bytes);
+    }
+    return buffer.data() + used;
+  }
+
+  void Commit(const std::uint8_t* end) { used = static_cast<std::size_t>(end - buffer.data()); }
+
+  std::uint8_t* PutPlayer(std::uint8_t* out, int player_id) {
+    out = PutVarint(out, ZigZag(player_id - lastPlayerId));
+    lastPlayerId = player_id;
+    return out;
+  }
+
+  void Grow(std::size_t required);
+};
+
+#endif //LIARSDICE_INCLUDE_PERSISTENCE_EVENTLOG_HPP
@@ -0,0 +1,32 @@
+//
+// Created by Brett on 10/16/2026.
+// Read-only memory mapping of a whole file.
+//
+
+#ifndef LIARSDICE_INCLUDE_PERSISTENCE_MAPPEDFILE_HPP
+#define LIARSDICE_INCLUDE_PERSISTENCE_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+class MappedFile {
+public:
+  // Maps the file read-only; throws FileException if it cannot be opened or mapped
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] std::span<const std::uint8_t> Bytes() const { return {data, size}; }
+
+private:
+  const std::uint8_t* data = nullptr;
+  std::size_t size = 0;
+  std::vector<std::uint8_t> fallback;  // Used where mmap is not available
+};
+
+#endif //LIARSDICE_INCLUDE_PERSISTENCE_MAPPEDFILE_HPP
@@ -0,0 +1,77 @@
+//
+// Created by Brett on 10/16/2026.
+// Zero-copy reader for event logs written by EventLogWriter.
+// The file is memory mapped; blocks and events are decoded in place and never copied.
+//
+
+#ifndef LIARSDICE_INCLUDE_PERSISTENCE_REPLAYREADER_HPP
+#define LIARSDICE_INCLUDE_PERSISTENCE_REPLAYREADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "EventLog.hpp"
+#include "MappedFile.hpp"
+
+// One decoded event. Fields not used by the event's type are left at zero.
+struct ReplayEvent {
+  EventType type{};
+  int playerId = 0;
+  int numPlayers = 0;
+  int diceCount = 0;
+  int diceValue = 0;
+  bool guesserWon = false;
+  unsigned ruleVariant = 0;
+  unsigned dieFaces = 0;  // Of a Faces event
+  // Face values of a Roll event. Faces are varints on disk but never exceed 127, so every face is
+  // exactly one byte and can be handed out straight from the mapping.
+  std::span<const std::uint8_t> faces;
+};
+
+// A self-contained run of whole games
+struct EventBlock {
+  std::span<const std::uint8_t> payload;
+  std::uint32_t gameCount = 0;
+  std::size_t fileOffset = 0;
+};
+
+// Decodes the events of one block in order
+class EventCursor {
+public:
+  explicit EventCursor(const EventBlock& block)
+      : pos(block.payload.data()), end(block.payload.data() + block.payload.size()) {}
+
+  // Decodes the next event into 'event'; returns false at the end of the block.
+  // Throws FileException on a malformed event.
+  bool Next(ReplayEvent& event);
+
+private:
+  const std::uint8_t* pos;
+  const std::uint8_t* end;
+  int lastPlayerId = 0;
+  int lastDiceCount = 0;
+
+  std::uint32_t ReadVarint();
+  int ReadPlayer();
+};
+
+class ReplayReader {
+public:
+  // Maps the log and indexes its blocks; throws FileException if it is not a valid event log
+  explicit ReplayReader(const std::string& filename);
+
+  [[nodiscard]] const std::vector<EventBlock>& Blocks() const { return blocks; }
+  [[nodiscard]] std::size_t SizeBytes() const { return file.Bytes().size(); }
+
+  // Bytes after the last complete block, left behind by a writer that did not finish its block
+  [[nodiscard]] std::size_t TruncatedBytes() const { return truncatedBytes; }
+
+private:
+  MappedFile file;
+  std::vector<EventBlock> blocks;
+  std::size_t truncatedBytes = 0;
+};
+
+#endif //LIARSDICE_INCLUDE_PERSISTENCE_REPLAYREADER_HPP
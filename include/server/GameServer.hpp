@@ -0,0 +1,62 @@
+//
+// Created by Brett on 10/16/2026.
+// Multi-table game server: one ServerLoop per thread, all listening on the same port, and one
+// Matchmaker whose seating thread deals full groups of waiting players out to the loops in turn.
+// With checkpoints on, a background thread flushes the loops' checkpoint files to disk.
+//
+
+#ifndef LIARSDICE_INCLUDE_SERVER_GAMESERVER_HPP
+#define LIARSDICE_INCLUDE_SERVER_GAMESERVER_HPP
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ServerLoop.hpp"
+
+class GameServer {
+public:
+  // Binds every loop's listening socket and restores checkpointed tables; throws NetworkException
+  // or FileException
+  explicit GameServer(const ServerOptions& options);
+  ~GameServer();
+
+  GameServer(const GameServer&) = delete;
+  GameServer& operator=(const GameServer&) = delete;
+
+  // Starts one thread per loop, the seating thread and the checkpoint thread
+  void Start();
+
+  // Asks every loop to return; async-signal-safe
+  void Stop();
+
+  // Joins the loop threads, then stops matchmaking
+  void Wait();
+
+  [[nodiscard]] MatchmakingStats Stats() const { return matchmaker.Stats(); }
+
+  [[nodiscard]] std::uint16_t Port() const { return loops.front()->Port(); }
+  [[nodiscard]] std::optional<std::uint16_t> SpectatorPort() const { return loops.front()->SpectatorPort(); }
+  [[nodiscard]] std::size_t LoopCount() const { return loops.size(); }
+  [[nodiscard]] std::size_t RestoredTables() const { return restoredTables; }
+
+private:
+  ServerMatchmaker matchmaker;
+  std::vector<std::unique_ptr<ServerLoop>> loops;
+  std::size_t nextLoop = 0;  // Seating thread only
+  std::vector<std::thread> threads;
+  std::atomic<bool> stopping{false};
+  bool checkpointing = false;
+  std::thread checkpointThread;
+  std::size_t restoredTables = 0;
+
+  void seatGroup(std::vector<ConnectionPtr>& group);
+  void restoreCheckpoints(const std::string& directory);
+};
+
+// Serves until SIGINT/SIGTERM and returns the process exit code for 'LiarsDice --server'
+int RunServer(const ServerOptions& options);
+
+#endif //LIARSDICE_INCLUDE_SERVER_GAMESERVER_HPP
@@ -0,0 +1,128 @@
+//
+// Created by Brett on 10/16/2026.
+// Matchmaking: any thread enqueues waiting players into a lock-free MpmcQueue, and a single seating
+// thread takes them out in arrival order and hands every full group of tableSize players to a
+// callback that opens a table for them.
+//
+
+#ifndef LIARSDICE_INCLUDE_SERVER_MATCHMAKER_HPP
+#define LIARSDICE_INCLUDE_SERVER_MATCHMAKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MpmcQueue.hpp"
+
+struct MatchmakingStats {
+  std::uint64_t enqueued = 0;
+  std::uint64_t rejected = 0;  // Enqueues refused because the queue was full
+  std::uint64_t tablesSeated = 0;
+  std::size_t depth = 0;     // Players in the queue right now
+  std::size_t maxDepth = 0;  // Deepest the queue has been seen by the seating thread
+};
+
+template <typename Waiting>
+class Matchmaker {
+public:
+  // Called on the seating thread with exactly tableSize players; may move them out of 'group'
+  using SeatTable = std::function<void(std::vector<Waiting>& group)>;
+
+  Matchmaker(int table_size, std::size_t capacity, SeatTable seat_table)
+      : queue(capacity), tableSize(static_cast<std::size_t>(table_size)), seatTable(std::move(seat_table)) {}
+
+  ~Matchmaker() { Stop(); }
+
+  Matchmaker(const Matchmaker&) = delete;
+  Matchmaker& operator=(const Matchmaker&) = delete;
+
+  void Start() {
+    seatingThread = std::thread([this] { run(); });
+  }
+
+  // Joins the seating thread; players still waiting are destroyed with the matchmaker
+  void Stop() {
+    stopping.store(true);
+    wakeSeatingThread();
+    if (seatingThread.joinable()) {
+      seatingThread.join();
+    }
+  }
+
+  // Safe from any thread. Returns false, leaving 'player' untouched, if the queue is full.
+  bool Enqueue(Waiting&& player) {
+    if (!queue.TryPush(std::move(player))) {
+      rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    enqueued.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the seating thread announcing its sleep before it re-checks the queue
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+      wakeSeatingThread();
+    }
+    return true;
+  }
+
+  [[nodiscard]] MatchmakingStats Stats() const {
+    return {enqueued.load(std::memory_order_relaxed), rejected.load(std::memory_order_relaxed),
+            tablesSeated.load(std::memory_order_relaxed), queue.ApproximateSize(),
+            maxDepth.load(std::memory_order_relaxed)};
+  }
+
+private:
+  MpmcQueue<Waiting> queue;
+  std::size_t tableSize;
+  SeatTable seatTable;
+  std::thread seatingThread;
+  std::atomic<bool> stopping{false};
+  std::atomic<bool> sleeping{false};
+  std::atomic<std::uint32_t> wakeups{0};
+  std::atomic<std::uint64_t> enqueued{0};
+  std::atomic<std::uint64_t> rejected{0};
+  std::atomic<std::uint64_t> tablesSeated{0};
+  std::atomic<std::size_t> maxDepth{0};
+
+  void wakeSeatingThread() {
+    wakeups.fetch_add(1, std::memory_order_release);
+    wakeups.notify_one();
+  }
+
+  void run() {
+    std::vector<Waiting> group;
+    group.reserve(tableSize);
+    Waiting player{};
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+      if (queue.TryPop(player)) {
+        // Counting the player just taken; pushes racing with the snapshot could overshoot capacity
+        std::size_t depth = std::min(queue.ApproximateSize() + 1, queue.Capacity());
+        if (depth > maxDepth.load(std::memory_order_relaxed)) {
+          maxDepth.store(depth, std::memory_order_relaxed);
+        }
+        group.push_back(std::move(player));
+        if (group.size() == tableSize) {
+          seatTable(group);
+          group.clear();
+          tablesSeated.fetch_add(1, std::memory_order_relaxed);
+        }
+        continue;
+      }
+
+      // Nothing to do: announce the sleep, make sure no push slipped in meanwhile, then park
+      std::uint32_t seen = wakeups.load(std::memory_order_acquire);
+      sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (queue.ApproximateSize() == 0 && !stopping.load(std::memory_order_relaxed)) {
+        wakeups.wait(seen, std::memory_order_acquire);
+      }
+      sleeping.store(false, std::memory_order_relaxed);
+    }
+  }
+};
+
+#endif //LIARSDICE_INCLUDE_SERVER_MATCHMAKER_HPP
@@ -0,0 +1,100 @@
+//
+// Created by Brett on 10/16/2026.
+// Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's array queue).
+//
+// Every cell carries a sequence number that tells producers and consumers whose turn it is, so a
+// push or pop is one compare-and-swap on the shared position plus one store on the cell; there is
+// no lock and no allocation after construction.
+//
+
+#ifndef LIARSDICE_INCLUDE_SERVER_MPMCQUEUE_HPP
+#define LIARSDICE_INCLUDE_SERVER_MPMCQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class MpmcQueue {
+public:
+  // Capacity is rounded up to a power of two
+  explicit MpmcQueue(std::size_t capacity)
+      : mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), cells(std::make_unique<Cell[]>(mask + 1)) {
+    for (std::size_t i = 0; i <= mask; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  // Returns false, leaving 'value' untouched, if the queue is full
+  bool TryPush(T&& value) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells[position & mask];
+      std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (lag == 0) {
+        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // The consumer has not freed this cell yet
+      } else {
+        position = enqueuePosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if the queue is empty
+  bool TryPop(T& value) {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells[position & mask];
+      std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (lag == 0) {
+        if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(position + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // No producer has filled this cell yet
+      } else {
+        position = dequeuePosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Items in the queue; only a snapshot while other threads push and pop
+  [[nodiscard]] std::size_t ApproximateSize() const {
+    std::size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+    std::size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  [[nodiscard]] std::size_t Capacity() const { return mask + 1; }
+
+private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value{};
+  };
+
+  const std::size_t mask;
+  const std::unique_ptr<Cell[]> cells;
+  // Producers and consumers spin on different lines
+  alignas(kCacheLine) std::atomic<std::size_t> enqueuePosition{0};
+  alignas(kCacheLine) std::atomic<std::size_t> dequeuePosition{0};
+};
+
+#endif //LIARSDICE_INCLUDE_SERVER_MPMCQUEUE_HPP
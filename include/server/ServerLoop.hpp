@@ -0,0 +1,188 @@
+//
+// Created by Brett on 10/16/2026.
+// One non-blocking epoll event loop of the game server. Every loop runs on its own thread with its
+// own listening socket (SO_REUSEPORT lets the kernel spread new connections across loops), its own
+// TableScheduler and its own tables. Loops only meet through the Matchmaker: a waiting connection
+// leaves its loop for the matchmaking queue, and the seating thread passes every full group to
+// the inbox of the loop that will host the table.
+//
+// Clients speak the binary protocol of WireProtocol.hpp. The call prompt after a bid goes to the
+// seat after the bidder.
+//
+// With a turn time set, every decision a seat owes is guarded by a deadline on the loop's
+// TimerWheel; when it passes, the server moves for the seat as if it had disconnected.
+//
+// With a checkpoint directory, every table's state is rewritten into the loop's CheckpointFile
+// whenever a decision is requested; that is a memcpy into a mapping, and a GameServer thread
+// flushes the files in the background. After a crash the tables are restored at startup with
+// their seats reserved: a player comes back by sending Resume with the seat key from Seated, and a
+// seat nobody reclaims in time is played like a disconnected one.
+//
+// Spectators connect to a separate port and never enter matchmaking; they Watch tables of the loop
+// that accepted them. Each table event is encoded once into SharedFrames and queued on every
+// watcher, so a table's cost per event does not grow with its audience.
+//
+
+#ifndef LIARSDICE_INCLUDE_SERVER_SERVERLOOP_HPP
+#define LIARSDICE_INCLUDE_SERVER_SERVERLOOP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CheckpointFile.hpp"
+#include "Game.hpp"
+#include "Matchmaker.hpp"
+#include "MpmcQueue.hpp"
+#include "PlayerDecisions.hpp"
+#include "TableManager.hpp"
+#include "TableScheduler.hpp"
+#include "TimerWheel.hpp"
+#include "WireProtocol.hpp"
+
+struct ServerOptions {
+  static constexpr int kMaxTableSize = 255;  // Player counts travel as one byte on the wire and in checkpoints
+
+  std::string host = "127.0.0.1";
+  std::uint16_t port = 7777;  // 0 picks a free port
+  unsigned loops = 0;         // 0 = one per hardware thread
+  int tableSize = 2;          // Players seated per table, at least 2 like Game::SetupPlayers
+  std::shared_ptr<const GameConfig> config = DefaultGameConfig();
+  std::size_t queueCapacity = 1 << 16;  // Waiting players the matchmaking queue can hold
+  std::optional<std::uint16_t> spectatorPort;  // Unset: no spectators; 0 picks a free port
+  std::chrono::milliseconds turnTime{0};       // Time to bid or call; 0 = no limit
+  std::string checkpointDir;                   // Empty: no checkpoints
+};
+
+// A client socket. It belongs to one loop at a time and travels through the Matchmaker between
+// tables, buffers and all.
+struct ServerConnection {
+  int fd = -1;
+  std::vector<std::uint8_t> input;   // Received bytes not yet decoded into frames
+  std::vector<std::uint8_t> output;  // Encoded frames the socket has not accepted yet
+  std::deque<SharedFrames> shared;   // Shared frames to send before 'output'
+  std::size_t sharedOffset = 0;      // Bytes of shared.front() already sent
+  bool writeArmed = false;
+  bool dirty = false;
+  TableHandle table;  // Invalid while waiting for a table
+  int seat = -1;
+  bool spectator = false;
+  TableHandle watching;         // The table a spectator watches
+  std::size_t watchIndex = 0;   // Position among that table's watchers
+  std::uint64_t resumeKey = 0;  // Seat to reclaim once the owning loop adopts the connection
+
+  ServerConnection() = default;
+  ServerConnection(const ServerConnection&) = delete;
+  ServerConnection& operator=(const ServerConnection&) = delete;
+  ~ServerConnection();  // Closes the socket
+};
+
+using ConnectionPtr = std::unique_ptr<ServerConnection>;
+using ServerMatchmaker = Matchmaker<ConnectionPtr>;
+
+class ServerLoop {
+public:
+  // Creates the loop's epoll instance and listening socket; throws NetworkException
+  // Loop 'index' also opens its checkpoint file; throws NetworkException or FileException
+  ServerLoop(const ServerOptions& options, unsigned index, std::uint16_t port,
+             std::optional<std::uint16_t> spectator_port, ServerMatchmaker& matchmaker);
+  ~ServerLoop();
+
+  ServerLoop(const ServerLoop&) = delete;
+  ServerLoop& operator=(const ServerLoop&) = delete;
+
+  // Serves connections until 'stopping' is set and Wake() is called
+  void Run(const std::atomic<bool>& stopping);
+
+  // Interrupts epoll_wait; safe to call from any thread and from a signal handler
+  void Wake() const;
+
+  // Opens a table for a full group of waiting players; safe from any thread. Returns false,
+  // leaving 'group' untouched, if the loop's inbox is full.
+  bool Seat(std::vector<ConnectionPtr>&& group);
+
+  // The loops Resume forwards connections between, indexed like the loops themselves
+  void SetPeers(std::vector<ServerLoop*> loops) { peers = std::move(loops); }
+
+  // Recreates the tables of this loop's checkpoint file and of 'orphans', files left by loops
+  // that no longer exist, which are deleted afterwards. Call before Run; returns the table count.
+  std::size_t RestoreCheckpoints(const std::vector<std::string>& orphans);
+
+  // Flushes the checkpoint file to disk; safe from any thread
+  void SyncCheckpoint() const;
+
+  // Hands over a connection that is resuming a seat at one of this loop's tables; safe from any
+  // thread. Returns false, leaving 'connection' untouched, if the loop's inbox is full.
+  bool Transfer(ConnectionPtr&& connection);
+
+  [[nodiscard]] std::uint16_t Port() const { return port; }
+  [[nodiscard]] std::optional<std::uint16_t> SpectatorPort() const { return spectatorPort; }
+
+private:
+  class Table;
+
+  using Connection = ServerConnection;
+
+  struct TurnTimer {
+    TableHandle table;
+    int seat = -1;
+  };
+
+  ServerOptions options;
+  unsigned index;
+  int epollFd = -1;
+  int listenFd = -1;
+  int wakeFd = -1;
+  int spectatorFd = -1;
+  std::uint16_t port = 0;
+  std::optional<std::uint16_t> spectatorPort;
+  ServerMatchmaker& matchmaker;
+  MpmcQueue<std::vector<ConnectionPtr>> inbox;  // Groups seated here by the matchmaker
+  MpmcQueue<ConnectionPtr> arrivals;             // Connections resuming a seat here
+  std::vector<ServerLoop*> peers;
+  std::vector<ConnectionPtr> connections;       // Indexed by fd
+  TableManager<Table> tables;
+  TableHandle newestTable;  // What a spectator asking for any table gets
+  std::vector<int> dirtyFds;
+  TableScheduler scheduler;
+  TimerWheel<TurnTimer> turnTimers;
+  std::unique_ptr<CheckpointFile> checkpoint;
+  std::string checkpointPath;
+  std::vector<std::uint8_t> checkpointRecord;  // Reused for every write
+  std::unordered_map<std::uint64_t, std::pair<TableHandle, int>> reservedSeats;  // By seat key
+  std::mt19937_64 seatKeys{std::random_device{}()};
+
+  void acceptConnections(int listen_fd);
+  void adopt(ConnectionPtr connection);
+  void readFrom(Connection& connection);
+  void writeTo(Connection& connection);
+  // Sends what the socket accepts without blocking; false on a hard error
+  static bool sendPending(Connection& connection);
+  void closeConnection(Connection& connection);
+  void handleFrame(Connection& connection, const Frame& frame);
+  // The connection's send buffer, flushed at the end of the loop iteration
+  std::vector<std::uint8_t>& outbox(Connection& connection);
+  // Queues frames encoded once for many connections, after everything queued before
+  void share(Connection& connection, const SharedFrames& frames);
+  void markDirty(Connection& connection);
+  void flushDirty();
+  // Takes the connection out of this loop (epoll and the fd table) so another loop can adopt it
+  ConnectionPtr detach(Connection& connection);
+  void enqueueWaiting(ConnectionPtr connection);
+  void openTables();
+  void finishTable(TableHandle handle);
+  void startWatching(Connection& spectator, const Frame& frame);
+  void resumeSeat(Connection& connection, std::uint64_t key);
+  std::uint64_t newSeatKey();
+  void checkpointTable(const Table& table, bool awaiting_call);
+  bool restoreTable(std::span<const std::uint8_t> record);
+  void stopWatching(Connection& spectator);
+};
+
+#endif //LIARSDICE_INCLUDE_SERVER_SERVERLOOP_HPP
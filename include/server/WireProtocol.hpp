@@ -0,0 +1,195 @@
+//
+// Created by Brett on 10/16/2026.
+// Binary wire protocol between the game server and its clients.
+//
+// Every message is one frame:
+//   u16 length (little-endian) of everything after it, u8 MessageType, payload
+// Integers are little-endian. A bid travels as a single bid rank, (count << 4) | face; rank 0 means
+// "no bid yet". Ranks only encode bids: whether one bid raises another is up to the rule variant.
+// Dice travel as a u8 die count followed by the faces packed two per byte, low nibble first.
+// Frames are decoded in place: ReadFrame hands out views into the receive buffer and FrameBuilder
+// encodes straight into the send buffer, so neither direction allocates per message.
+// Frames that many connections receive alike (spectator updates, the end of a game) are encoded
+// once into SharedFrames and the same buffer is queued on every connection.
+//
+
+#ifndef LIARSDICE_INCLUDE_SERVER_WIREPROTOCOL_HPP
+#define LIARSDICE_INCLUDE_SERVER_WIREPROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Dice.hpp"
+#include "Guess.hpp"
+
+inline constexpr std::size_t kFrameLengthSize = 2;
+inline constexpr std::size_t kMaxFrameLength = 1024;  // Type byte included
+
+enum class MessageType : std::uint8_t {
+  // Server to client
+  Waiting = 0x01,     // empty
+  Seated = 0x02,      // u8 player id, u8 players at the table, u64 seat key for Resume
+  Dice = 0x03,        // packed dice of the receiving player
+  Turn = 0x04,        // u32 rank of the bid to beat; answer with PlaceBid
+  BidMade = 0x05,     // u8 player id, u32 bid rank
+  CallPrompt = 0x06,  // empty; answer with Call
+  Invalid = 0x07,     // u32 rejected bid rank, validation message as text
+  Error = 0x08,       // u8 WireError
+  Reveal = 0x09,      // u8 player id, packed dice
+  Result = 0x0A,      // u8 winner (0 = guessing player, 1 = calling player), u32 final bid rank, u16 actual count
+  Watching = 0x0B,    // u32 table id, u8 players at the table; a Snapshot follows
+  Snapshot = 0x0C,    // u8 players, u32 rank of the current bid, u8 dice left per player
+  TimedOut = 0x0D,    // empty; the turn time ran out and the server bid the minimum raise or called liar
+
+  // Client to server
+  PlaceBid = 0x81,  // u32 bid rank
+  Call = 0x82,      // u8 CallType, spot-on only at tables whose rules allow it
+  Watch = 0x83,     // Spectators only: u32 table id, 0 = any table
+  Resume = 0x84,    // On the watch port: u64 seat key of a table restored from a checkpoint
+};
+
+enum class WireError : std::uint8_t {
+  Malformed = 1,    // Unknown message type or wrong payload size
+  NotYourTurn = 2,  // Nothing is waiting for this message
+  NotSeated = 3,    // Still waiting for a table
+  ServerBusy = 4,   // The matchmaking queue is full; the server closes the connection
+  NoSuchTable = 5,  // Watch or Resume named a table or seat that is not being played
+};
+
+// Immutable encoded frames shared by every connection they are queued on
+using SharedFrames = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+constexpr std::uint32_t BidRank(int dice_count, int dice_value) {
+  return (static_cast<std::uint32_t>(dice_count) << 4) | (static_cast<std::uint32_t>(dice_value) & 0xF);
+}
+
+constexpr std::pair<int, int> BidFromRank(std::uint32_t rank) {
+  return {static_cast<int>(rank >> 4), static_cast<int>(rank & 0xF)};
+}
+
+// The face of die 'index' in packed dice
+constexpr unsigned PackedFace(std::span<const std::uint8_t> packed, std::size_t index) {
+  return (packed[index / 2] >> (index % 2 * 4)) & 0xF;
+}
+
+struct Frame {
+  MessageType type;
+  std::span<const std::uint8_t> payload;
+};
+
+enum class FrameStatus {
+  Complete,
+  Incomplete,  // Wait for more bytes
+  Malformed,   // Length out of range; drop the connection
+};
+
+// Decodes the frame at the front of 'buffer' and advances 'buffer' past it
+inline FrameStatus ReadFrame(std::span<const std::uint8_t>& buffer, Frame& frame) {
+  if (buffer.size() < kFrameLengthSize) {
+    return FrameStatus::Incomplete;
+  }
+  std::size_t length = buffer[0] | static_cast<std::size_t>(buffer[1]) << 8;
+  if (length == 0 || length > kMaxFrameLength) {
+    return FrameStatus::Malformed;
+  }
+  if (buffer.size() < kFrameLengthSize + length) {
+    return FrameStatus::Incomplete;
+  }
+  frame.type = static_cast<MessageType>(buffer[kFrameLengthSize]);
+  frame.payload = buffer.subspan(kFrameLengthSize + 1, length - 1);
+  buffer = buffer.subspan(kFrameLengthSize + length);
+  return FrameStatus::Complete;
+}
+
+// Bounds-checked reads from a frame payload; a read past the end returns 0 and fails Done()
+class PayloadReader {
+public:
+  explicit PayloadReader(std::span<const std::uint8_t> payload) : payload(payload) {}
+
+  std::uint8_t U8() { return static_cast<std::uint8_t>(take(1)); }
+  std::uint16_t U16() { return static_cast<std::uint16_t>(take(2)); }
+  std::uint32_t U32() { return take(4); }
+  std::uint64_t U64() {
+    std::uint64_t low = take(4);
+    return low | static_cast<std::uint64_t>(take(4)) << 32;
+  }
+
+  // True if every read succeeded and the whole payload was consumed
+  [[nodiscard]] bool Done() const { return ok && offset == payload.size(); }
+
+private:
+  std::span<const std::uint8_t> payload;
+  std::size_t offset = 0;
+  bool ok = true;
+
+  std::uint32_t take(std::size_t bytes) {
+    if (offset + bytes > payload.size()) {
+      ok = false;
+      return 0;
+    }
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+      value |= static_cast<std::uint32_t>(payload[offset + i]) << (8 * i);
+    }
+    offset += bytes;
+    return value;
+  }
+};
+
+// Appends one frame to a send buffer; the length is filled in when the builder goes out of scope,
+// so a whole message is a single expression: FrameBuilder(out, MessageType::Turn).U32(rank);
+class FrameBuilder {
+public:
+  FrameBuilder(std::vector<std::uint8_t>& out, MessageType type) : out(out), start(out.size()) {
+    out.resize(start + kFrameLengthSize);
+    out.push_back(static_cast<std::uint8_t>(type));
+  }
+
+  ~FrameBuilder() {
+    std::size_t length = out.size() - start - kFrameLengthSize;
+    out[start] = static_cast<std::uint8_t>(length);
+    out[start + 1] = static_cast<std::uint8_t>(length >> 8);
+  }
+
+  FrameBuilder(const FrameBuilder&) = delete;
+  FrameBuilder& operator=(const FrameBuilder&) = delete;
+
+  FrameBuilder& U8(std::uint8_t value) { return put(value, 1); }
+  FrameBuilder& U16(std::uint16_t value) { return put(value, 2); }
+  FrameBuilder& U32(std::uint32_t value) { return put(value, 4); }
+  FrameBuilder& U64(std::uint64_t value) { return put(static_cast<std::uint32_t>(value), 4).put(static_cast<std::uint32_t>(value >> 32), 4); }
+
+  FrameBuilder& Faces(const std::vector<Dice>& dice) {
+    U8(static_cast<std::uint8_t>(dice.size()));
+    for (std::size_t i = 0; i < dice.size(); i += 2) {
+      unsigned high = i + 1 < dice.size() ? dice[i + 1].GetFaceValue() : 0;
+      out.push_back(static_cast<std::uint8_t>((dice[i].GetFaceValue() & 0xF) | (high & 0xF) << 4));
+    }
+    return *this;
+  }
+
+  // Text runs to the end of the frame, truncated to fit kMaxFrameLength
+  FrameBuilder& Text(std::string_view text) {
+    std::size_t room = kMaxFrameLength - (out.size() - start - kFrameLengthSize);
+    text = text.substr(0, room);
+    out.insert(out.end(), text.begin(), text.end());
+    return *this;
+  }
+
+private:
+  std::vector<std::uint8_t>& out;
+  std::size_t start;
+
+  FrameBuilder& put(std::uint32_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+      out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+    return *this;
+  }
+};
+
+#endif //LIARSDICE_INCLUDE_SERVER_WIREPROTOCOL_HPP
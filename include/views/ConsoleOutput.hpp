@@ -0,0 +1,26 @@
+//
+// Created by Brett on 10/16/2026.
+// Console output in large writes. std::cout stops synchronising with C stdio and collects
+// everything the game prints in one big user-space buffer, and std::cin no longer flushes it
+// before every read. Output reaches the terminal only at the flush points: once per prompt, right
+// before the game would wait for the player, when the buffer fills, and at exit. Input that is
+// already waiting (a script, a pipe, a paste) needs no flush, so a scripted game writes in
+// buffer-sized blocks.
+//
+
+#ifndef LIARSDICE_INCLUDE_VIEWS_CONSOLEOUTPUT_HPP
+#define LIARSDICE_INCLUDE_VIEWS_CONSOLEOUTPUT_HPP
+
+#include <string_view>
+
+// Sets up the buffering; call once at startup before anything is printed
+void BufferConsoleOutput();
+
+// Writes out everything printed so far unless the next input is already available; call right
+// before reading input
+void FlushConsoleOutput();
+
+// Writes all of 'data' to a file descriptor, retrying partial writes and interrupted calls
+void WriteFully(int fd, std::string_view data);
+
+#endif //LIARSDICE_INCLUDE_VIEWS_CONSOLEOUTPUT_HPP
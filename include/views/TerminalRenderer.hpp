@@ -0,0 +1,76 @@
+//
+// Created by Brett on 10/16/2026.
+// Draws the console game one frame at a time. A frame (rules, game state, prompt) is built in one
+// buffer and shown with a single write of ANSI sequences, instead of spawning a shell to clear the
+// screen. On standard output the frame joins std::cout's buffer and goes out with the prompt at
+// the next flush point (see ConsoleOutput.hpp).
+//
+// The renderer remembers the frame on screen and repaints only what changed: lines that are the
+// same are skipped, and a changed line is rewritten from its first differing column. The last
+// line of a frame is its prompt, after which the player's input and any further output land, so
+// from there down the screen is always cleared and redrawn. The first frame, a frame taller than
+// the terminal, and any frame after Invalidate clear the whole screen.
+//
+
+#ifndef LIARSDICE_INCLUDE_VIEWS_TERMINALRENDERER_HPP
+#define LIARSDICE_INCLUDE_VIEWS_TERMINALRENDERER_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TerminalRenderer {
+public:
+  static constexpr int kStandardOutput = 1;
+
+  // Draws to the given file descriptor, standard output by default
+  explicit TerminalRenderer(int fd = kStandardOutput);
+
+  // Starts a new frame that replaces everything on screen
+  void BeginFrame();
+
+  TerminalRenderer& operator<<(std::string_view text) {
+    frame.append(text);
+    return *this;
+  }
+
+  TerminalRenderer& operator<<(char c) {
+    frame.push_back(c);
+    return *this;
+  }
+
+  TerminalRenderer& operator<<(std::integral auto value) {
+    appendNumber(static_cast<long long>(value));
+    return *this;
+  }
+
+  // Brings the screen from the previous frame to this one. On standard output that is queued on
+  // std::cout; any other descriptor gets one write, after std::cout is flushed to keep the order.
+  void Present();
+
+  // Forgets what is on screen, e.g. after other output may have scrolled it; the next frame is
+  // drawn in full
+  void Invalidate() { shownValid = false; }
+
+  [[nodiscard]] const std::string& Frame() const { return frame; }
+
+  // Bytes the last Present wrote, escape sequences included
+  [[nodiscard]] std::size_t LastWriteSize() const { return output.size(); }
+
+private:
+  int fd;
+  std::string frame;   // Being built; keeps its capacity from one frame to the next
+  std::string shown;   // The frame on screen
+  bool shownValid = false;
+  std::string output;  // Escape sequences and text of one Present
+  std::vector<std::string_view> frameLines;
+  std::vector<std::string_view> shownLines;
+
+  void appendNumber(long long value);
+  void appendCursorMove(std::size_t row, std::size_t column);
+  [[nodiscard]] bool fitsTerminal(std::size_t lines) const;
+};
+
+#endif //LIARSDICE_INCLUDE_VIEWS_TERMINALRENDERER_HPP
@@ -0,0 +1,278 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the GameAnalytics class.
+//
+
+#include "GameAnalytics.hpp"
+#include "BidProbability.hpp"
+#include "CustomException.hpp"
+#include "FileException.hpp"
+#include "GameConfig.hpp"
+#include "RuleEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <thread>
+
+namespace {
+
+// Tallies of the game currently being scanned; only committed once the game is resolved
+struct GameTally {
+  std::uint64_t bids = 0;
+  std::uint64_t rejectedBids = 0;
+  std::uint64_t bluffs = 0;
+  int numPlayers = 0;
+  int totalDice = 0;
+  int firstBidder = 0;
+  int lastBidder = 0;
+  int lastCount = 0;
+  int lastValue = 0;
+  int caller = 0;
+  CallType call = CallType::Pass;
+  int callBucket = -1;
+  RuleVariant rules;
+  int faces = Dice::kDefaultFaces;
+};
+
+double Percent(std::uint64_t part, std::uint64_t whole) {
+  return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+} // namespace
+
+void AnalyticsPartial::Merge(const AnalyticsPartial& other) {
+  games += other.games;
+  bids += other.bids;
+  rejectedBids += other.rejectedBids;
+  bluffs += other.bluffs;
+  liarCalls += other.liarCalls;
+  correctCalls += other.correctCalls;
+  spotOnCalls += other.spotOnCalls;
+  correctSpotOnCalls += other.correctSpotOnCalls;
+  for (int i = 0; i < kProbabilityBuckets; ++i) {
+    callsByBucket[i] += other.callsByBucket[i];
+    correctCallsByBucket[i] += other.correctCallsByBucket[i];
+  }
+  firstBidderWins += other.firstBidderWins;
+  expectedFirstBidderWins += other.expectedFirstBidderWins;
+  selfCalledGames += other.selfCalledGames;
+  corruptBlocks += other.corruptBlocks;
+}
+
+AnalyticsPartial GameAnalytics::Scan(const ReplayReader& reader, unsigned threads) {
+  const auto& blocks = reader.Blocks();
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(blocks.size(), 1)));
+
+  // Workers pull blocks from a shared counter so uneven blocks still balance out
+  std::vector<AnalyticsPartial> partials(threads);
+  std::atomic<std::size_t> nextBlock{0};
+  auto worker = [&](AnalyticsPartial& partial) {
+    for (std::size_t i = nextBlock.fetch_add(1, std::memory_order_relaxed); i < blocks.size();
+         i = nextBlock.fetch_add(1, std::memory_order_relaxed)) {
+      ScanBlock(blocks[i], partial);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) {
+    pool.emplace_back(worker, std::ref(partials[t]));
+  }
+  worker(partials[0]);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  AnalyticsPartial totals;
+  for (const auto& partial : partials) {
+    totals.Merge(partial);
+  }
+  return totals;
+}
+
+void GameAnalytics::ScanBlock(const EventBlock& block, AnalyticsPartial& partial) {
+  AnalyticsPartial local;
+  EventCursor cursor(block);
+  ReplayEvent event;
+  std::vector<std::span<const std::uint8_t>> hands;
+  std::array<int, 128> faceCounts{};
+  GameTally game;
+  bool inGame = false;
+
+  // As RuleEngine::CountMatching: ones count toward other faces unless a palifico round suspends it
+  auto onesWild = [&] {
+    bool palificoRound = game.rules.palifico && !hands.empty() && hands.front().size() == 1;
+    return game.rules.wildOnes && !palificoRound;
+  };
+  auto matching = [&](auto first, auto last, int face) {
+    bool wild = onesWild() && face != 1;
+    return static_cast<int>(std::count_if(first, last, [&](int die) { return die == face || (wild && die == 1); }));
+  };
+
+  try {
+    while (cursor.Next(event)) {
+      switch (event.type) {
+        case EventType::GameStart:
+          game = GameTally{};
+          game.numPlayers = event.numPlayers;
+          hands.assign(event.numPlayers, {});
+          faceCounts.fill(0);
+          inGame = true;
+          break;
+        case EventType::Roll:
+          if (event.playerId >= 1 && event.playerId <= game.numPlayers) {
+            hands[event.playerId - 1] = event.faces;
+            for (std::uint8_t face : event.faces) {
+              ++faceCounts[face];
+            }
+            game.totalDice += static_cast<int>(event.faces.size());
+          }
+          break;
+        case EventType::Bid:
+          ++game.bids;
+          if (game.firstBidder == 0) {
+            game.firstBidder = event.playerId;
+          }
+          game.lastBidder = event.playerId;
+          game.lastCount = event.diceCount;
+          game.lastValue = event.diceValue;
+          if (event.diceValue < 1 || event.diceValue >= static_cast<int>(faceCounts.size()) ||
+              faceCounts[event.diceValue] + (onesWild() && event.diceValue != 1 ? faceCounts[1] : 0) <
+                  event.diceCount) {
+            ++game.bluffs;
+          }
+          break;
+        case EventType::RejectedBid:
+          ++game.rejectedBids;
+          break;
+        case EventType::SpotOnCall:
+          game.caller = event.playerId;  // Tallied on its own, not bucketed by liar probability
+          game.call = CallType::SpotOn;
+          break;
+        case EventType::Rules:
+          game.rules = RuleVariant::FromIndex(event.ruleVariant % kRuleVariantCount);
+          break;
+        case EventType::Faces:
+          game.faces = static_cast<int>(std::clamp(event.dieFaces, 2u, GameConfig::kMaxFaces));
+          break;
+        case EventType::LiarCall:
+          game.caller = event.playerId;
+          game.call = CallType::Liar;
+          if (event.playerId >= 1 && event.playerId <= game.numPlayers) {
+            const auto& hand = hands[event.playerId - 1];
+            int own = matching(hand.begin(), hand.end(), game.lastValue);
+            int unknown = game.totalDice - static_cast<int>(hand.size());
+            double probability = ProbabilityAtLeast(game.lastCount - own, unknown,
+                                                    MatchChance(game.lastValue, game.faces, onesWild()));
+            game.callBucket = std::min(static_cast<int>(probability * AnalyticsPartial::kProbabilityBuckets),
+                                       AnalyticsPartial::kProbabilityBuckets - 1);
+          }
+          break;
+        case EventType::Resolution: {
+          if (!inGame || game.caller == 0) {
+            break;
+          }
+          inGame = false;
+          ++local.games;
+          local.bids += game.bids;
+          local.rejectedBids += game.rejectedBids;
+          local.bluffs += game.bluffs;
+          if (game.call == CallType::SpotOn) {
+            ++local.spotOnCalls;
+            if (!event.guesserWon) {
+              ++local.correctSpotOnCalls;
+            }
+          } else {
+            ++local.liarCalls;
+            if (!event.guesserWon) {
+              ++local.correctCalls;
+            }
+          }
+          if (game.caller == game.lastBidder) {
+            ++local.selfCalledGames;
+            break;
+          }
+          if (game.callBucket >= 0) {
+            ++local.callsByBucket[game.callBucket];
+            if (!event.guesserWon) {
+              ++local.correctCallsByBucket[game.callBucket];
+            }
+          }
+          int winner = event.guesserWon ? game.lastBidder : game.caller;
+          if (game.firstBidder != 0 && winner == game.firstBidder) {
+            ++local.firstBidderWins;
+          }
+          local.expectedFirstBidderWins += 1.0 / std::max(game.numPlayers, 1);
+          break;
+        }
+      }
+    }
+  } catch (const FileException&) {
+    ++partial.corruptBlocks;
+    return;
+  }
+  partial.Merge(local);
+}
+
+void GameAnalytics::PrintReport(const AnalyticsPartial& totals, std::ostream& out) {
+  auto games = static_cast<double>(std::max<std::uint64_t>(totals.games, 1));
+  out << std::fixed << std::setprecision(2);
+  out << "Games analysed:         " << totals.games << '\n';
+  out << "Average round length:   " << static_cast<double>(totals.bids) / games << " bids ("
+      << static_cast<double>(totals.rejectedBids) / games << " rejected bids per game)\n";
+  out << "Bluff rate:             " << Percent(totals.bluffs, totals.bids)
+      << "% of accepted bids claimed more dice than were on the table\n";
+  out << "Liar-call accuracy:     " << Percent(totals.correctCalls, totals.liarCalls)
+      << "% of liar calls were won by the caller\n";
+  out << "  P(bid true) to caller    calls   accuracy\n";
+  for (int i = 0; i < AnalyticsPartial::kProbabilityBuckets; ++i) {
+    out << "  " << std::setprecision(1) << static_cast<double>(i) / AnalyticsPartial::kProbabilityBuckets << " - "
+        << static_cast<double>(i + 1) / AnalyticsPartial::kProbabilityBuckets << std::setw(21)
+        << totals.callsByBucket[i] << std::setw(10) << std::setprecision(2)
+        << Percent(totals.correctCallsByBucket[i], totals.callsByBucket[i]) << "%\n";
+  }
+  if (totals.spotOnCalls != 0) {
+    out << "Spot-on accuracy:       " << Percent(totals.correctSpotOnCalls, totals.spotOnCalls) << "% of "
+        << totals.spotOnCalls << " spot-on calls were won by the caller\n";
+  }
+  auto attributedGames = totals.games - totals.selfCalledGames;
+  out << "First-player advantage: first bidder won " << Percent(totals.firstBidderWins, attributedGames)
+      << "% of games ("
+      << 100.0 * totals.expectedFirstBidderWins / static_cast<double>(std::max<std::uint64_t>(attributedGames, 1))
+      << "% expected with no advantage)\n";
+  if (totals.selfCalledGames != 0) {
+    out << "Left " << totals.selfCalledGames << " games from older logs, where the bidder is recorded as the caller,"
+        << " out of the call buckets and first-player advantage\n";
+  }
+  if (totals.corruptBlocks != 0) {
+    out << "Skipped " << totals.corruptBlocks << " corrupt blocks\n";
+  }
+  out << std::defaultfloat;
+}
+
+int RunAnalytics(const std::vector<std::string>& filenames) {
+  AnalyticsPartial totals;
+  std::uint64_t bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    for (const auto& filename : filenames) {
+      ReplayReader reader(filename);
+      totals.Merge(GameAnalytics::Scan(reader));
+      bytes += reader.SizeBytes();
+    }
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  GameAnalytics::PrintReport(totals, std::cout);
+  std::cout << "Scanned " << bytes << " bytes in " << elapsed.count() << " s\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the BotDecisions class.
+//
+
+#include "BotDecisions.hpp"
+#include "BidProbability.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr double BLUFF_CHANCE = 0.15;
+
+} // namespace
+
+BotDecisions::BotDecisions(std::uint32_t seed, std::chrono::microseconds think_time, int faces, RuleVariant rules)
+    : rng(seed), thinkTime(think_time), faces(faces), rules(rules) {
+}
+
+void BotDecisions::RequestGuess(GuessRequest& request) {
+  TRACE_SPAN(Input);
+  const Guess& last = request.lastGuess;
+  // Once a palifico round is opened only the count may rise
+  if (rules.palifico && request.palificoRound && last.diceCount != 0) {
+    answer(request, std::pair<int, int>{last.diceCount + 1, last.diceValue});
+    return;
+  }
+  std::array<int, kMaxFaces + 1> own = countFaces(request.player);
+
+  // Back the face we hold most of (the higher one on ties), or occasionally any face at all
+  int face = faces;
+  for (int f = faces - 1; f >= 1; --f) {
+    if (own[f] > own[face]) {
+      face = f;
+    }
+  }
+  if (std::uniform_real_distribution<>(0, 1)(rng) < BLUFF_CHANCE) {
+    face = std::uniform_int_distribution<>(1, faces)(rng);
+  }
+
+  // Smallest raise on that face: the same count on a higher face, otherwise one more die
+  int count = face > last.diceValue ? std::max(last.diceCount, 1) : last.diceCount + 1;
+  answer(request, std::pair<int, int>{count, face});
+}
+
+void BotDecisions::RequestLiarCall(LiarCallRequest& request) {
+  TRACE_SPAN(Input);
+  // Judged from the caller's dice: the bidder's own hand is what made the bid
+  const Player& caller = request.caller != nullptr ? *request.caller : request.player;
+  std::array<int, kMaxFaces + 1> own = countFaces(caller);
+  const Guess& last = request.lastGuess;
+  bool onesWild = rules.wildOnes && !(rules.palifico && request.palificoRound);
+  int held = 0;
+  if (last.diceValue >= 1 && last.diceValue <= faces) {
+    held = own[last.diceValue] + (onesWild && last.diceValue != 1 ? own[1] : 0);
+  }
+  int unknown = request.totalDice - static_cast<int>(caller.GetDice().size());
+
+  double probability =
+      ProbabilityAtLeast(last.diceCount - held, unknown, MatchChance(last.diceValue, faces, onesWild));
+  answer(request, probability < std::uniform_real_distribution<>(0.3, 0.7)(rng) ? CallType::Liar : CallType::Pass);
+}
+
+template <typename T>
+void BotDecisions::answer(DecisionRequest<T>& request, T decision) {
+  if (thinkTime.count() == 0) {
+    request.Complete(std::move(decision));
+    return;
+  }
+  // Jitter the think-time so tables drift apart instead of waking in lockstep
+  auto jitter = std::uniform_int_distribution<std::int64_t>(thinkTime.count() / 2, thinkTime.count() * 3 / 2)(rng);
+  request.CompleteAt(std::move(decision), TableScheduler::Clock::now() + std::chrono::microseconds(jitter));
+}
+
+std::array<int, BotDecisions::kMaxFaces + 1> BotDecisions::countFaces(const Player& player) {
+  std::array<int, kMaxFaces + 1> counts{};
+  for (const auto& die : player.GetDice()) {
+    if (die.GetFaceValue() <= kMaxFaces) {
+      ++counts[die.GetFaceValue()];
+    }
+  }
+  return counts;
+}
@@ -4,9 +4,13 @@
 //
 
 #include "Game.hpp"
-#include "FileException.hpp"
+#include "GameLogicException.hpp"
+#include "EventLog.hpp"
+#include "InputException.hpp"
+#include "LineReader.hpp"
+#include "Trace.hpp"
+#include <charconv>
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <stdexcept>
 
@@ -17,103 +21,271 @@ const std::string INVALID_GUESS_MSG_FACE_VALUE = "Invalid guess. You have the sa
                                                  "is not greater.\n";
 const std::string INVALID_GUESS_MSG_DICE_COUNT = "Invalid guess. You have fewer dice but the face value is not "
                                                  "greater than the last guess.\n";
+const std::string INVALID_GUESS_MSG_PALIFICO = "Invalid guess. In a palifico round only the number of dice may be "
+                                               "raised.\n";
+const std::string TIME_UP_MSG = "\nTime is up; ";
 
 // Constructor implementation
-Game::Game() : currentPlayerIndex(0), lastGuess({0, 0}) {
+Game::Game()
+    : currentPlayerIndex(0), lastGuess({0, 0}), config(DefaultGameConfig()), rules(&SelectRules({})),
+      input(&ConsoleInput()) {
 
 }
 
 void Game::Init() {
-  try {
-    rulesText = ReadRulesFromFile("./assets/rules.txt");
-    std::cout << rulesText;
-  } catch (const FileException& e) {
-    std::cerr << e.what() << std::endl;
-    std::cerr << "Ensure 'assets/rules.txt' exists in the same directory as 'LiarsDice.exe'.";
-    exit(EXIT_FAILURE); // Exit the game
+  if (input->Interactive()) {
+    std::cout << config->rulesText;
   }
 
   SetupPlayers();
   PlayGame();
 }
 
-std::string Game::ReadRulesFromFile(const std::string& filename) {
-  std::string rulesContent;
-  std::ifstream file_handle(filename);
-
-  // Check if the file could be opened
-  if (!file_handle) {
-    throw FileException("Could not open rules.txt");
-  }
-
-  std::string line;
-  while (std::getline(file_handle, line)) {
-    rulesContent += line + '\n';
+void Game::SetConfig(std::shared_ptr<const GameConfig> game_config) {
+  if (game_config == config) {
+    return;  // Recycled tables keep their players
   }
-  return rulesContent;
+  config = std::move(game_config);
+  players.clear();  // Reseated with the configured dice by the next ResetTable
+  SetRules(config->rules);
 }
 
 void Game::SetupPlayers() {
   // Validate the number of players
-  std::cout << "Enter the number of players: ";
   int num_players;
-  GetSetupInput(num_players);
+  GetSetupInput("Enter the number of players: ", num_players);
 
   while (num_players < 2) {
-    std::cout << "Please enter a number greater than 1: ";
-    GetSetupInput(num_players);
+    GetSetupInput("Please enter a number greater than 1: ", num_players);
+  }
+  ResetTable(num_players);
+  RollDice();
+}
+
+void Game::RollDice() {
+  TRACE_SPAN(Roll);
+  for (auto& player : players) {
+    player.RollDice();
+  }
+}
+
+void Game::ResetTable(int num_players) {
+  if (players.size() > static_cast<std::size_t>(num_players)) {
+    players.erase(players.begin() + num_players, players.end());
   }
   players.reserve(num_players);
-  for (int i = 1; i <= num_players; ++i) {
-    players.emplace_back(i);
+  for (int i = static_cast<int>(players.size()) + 1; i <= num_players; ++i) {
+    players.emplace_back(i, config->dicePerPlayer, config->faces);
   }
+  currentPlayerIndex = 0;
+  lastGuess = Guess({0, 0});
+  resumeAtCall = false;
+  updatePalificoRound();
 }
 
-void Game::GetSetupInput(int& num_players) {
-  std::cin >> num_players;
-  std::cin.clear();
-  std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+void Game::RestoreTurn(int current_player_index, const Guess& last_guess, bool awaiting_call) {
+  if (current_player_index < 0 || current_player_index >= static_cast<int>(players.size())) {
+    throw GameLogicException("No player at index " + std::to_string(current_player_index));
+  }
+  currentPlayerIndex = current_player_index;
+  lastGuess = last_guess;
+  resumeAtCall = awaiting_call;
 }
 
-void Game::PlayGame() {
-  while (true) {
-    // Clear the screen
-    system("cls");
+void Game::SetRules(RuleVariant variant) {
+  rules = &SelectRules(variant);
+  updatePalificoRound();
+}
+
+// A palifico round is one opened by a player holding a single die
+void Game::updatePalificoRound() {
+  palificoRound = rules->variant.palifico && !players.empty() && players.front().GetDice().size() == 1;
+}
+
+void Game::SetPlayerDice(int player_id, std::span<const std::uint8_t> faces) {
+  if (player_id < 1 || player_id > static_cast<int>(players.size())) {
+    throw GameLogicException("No player with id " + std::to_string(player_id));
+  }
+  players[player_id - 1].SetDice(faces);
+  updatePalificoRound();
+}
+
+void Game::GetSetupInput(std::string_view prompt, int& num_players) {
+  std::string line;
+  if (input->ReadLine(prompt, line) != ReadStatus::Line) {
+    throw InputException("Input ended while waiting for the number of players");
+  }
+  // Anything that does not start with a number asks again
+  auto start = line.find_first_not_of(" \t");
+  const char* first = line.data() + (start == std::string::npos ? line.size() : start);
+  if (std::from_chars(first, line.data() + line.size(), num_players).ec != std::errc{}) {
+    num_players = 0;
+  }
+}
 
-    // Display the rules
-    std::cout << rulesText;
+void Game::PlayGame() {
+  beginGame();
+  screen.Invalidate();  // Setup prompts and earlier games have scrolled the screen
+  bool interactive = input->Interactive();
 
+  std::string validationError;
+  Player::Deadline deadline = turnDeadline();
+  while (true) {
     Player& currentPlayer = players[currentPlayerIndex];
-    displayCurrentState(currentPlayer);
+    if (interactive) {
+      TRACE_SPAN(Render);
+      // Redraw the screen: rules, state, the rejected guess if any, and the prompt
+      screen.BeginFrame();
+      screen << config->rulesText;
+      displayCurrentState(currentPlayer);
+      screen << validationError << Player::kGuessPrompt;
+      screen.Present();
+    }
 
-    auto guess = Guess(currentPlayer.MakeGuess());
-    std::string validationError = ValidateGuess(guess, lastGuess);
+    // Rejected guesses do not restart the clock
+    auto bid = currentPlayer.MakeGuess(*input, interactive, deadline);
+    if (!bid) {
+      bid = MinimumRaise(lastGuess);
+      std::cout << TIME_UP_MSG << "bidding " << bid->first << ", " << bid->second << '\n';
+    }
+    auto guess = Guess(*bid);
+    validationError = applyGuess(currentPlayer, guess);
 
     if (!validationError.empty()) {
-      std::cout << validationError;
+      if (!interactive) {
+        std::cerr << validationError;  // Nobody sees the next screen
+      }
       continue;
     }
 
-    lastGuess = guess;
-
-    if (currentPlayer.CallLiar()) {
-      std::string winner = CheckGuessAgainstDice(lastGuess);
+    // The next player decides whether to challenge the bid
+    Player& caller = nextPlayer();
+    auto call = caller.CallLiar(*input, rules->variant.spotOn, turnDeadline());
+    if (!call) {
+      call = CallType::Liar;
+      std::cout << TIME_UP_MSG << "calling liar\n";
+    }
+    if (*call != CallType::Pass) {
+      std::string winner = resolveCall(caller, *call);
       std::cout << "The winner is " << winner << '\n';
       break;
     }
 
     updateCurrentPlayerIndex();
+    deadline = turnDeadline();
+  }
+}
+
+// A decision asked for now is due by this time
+Player::Deadline Game::turnDeadline() const {
+  return turnTime.count() > 0 ? std::chrono::steady_clock::now() + turnTime : Player::kNoDeadline;
+}
+
+GameTask Game::PlayGameAsync(PlayerDecisions& decisions) {
+  beginGame();
+  bool awaitingCall = std::exchange(resumeAtCall, false);
+  if (awaitingCall) {
+    lastOutcome.guessingPlayerId = players[currentPlayerIndex].GetPlayerId();
+  }
+
+  while (true) {
+    Player& currentPlayer = players[currentPlayerIndex];
+
+    if (!std::exchange(awaitingCall, false)) {
+      auto guess = Guess(co_await GuessRequest(decisions, currentPlayer, lastGuess, diceInPlay, palificoRound));
+      std::string validationError = applyGuess(currentPlayer, guess);
+
+      if (!validationError.empty()) {
+        decisions.OnInvalidGuess(currentPlayer, validationError);
+        continue;
+      }
+    }
+
+    LiarCallRequest callRequest(decisions, currentPlayer, lastGuess, diceInPlay, palificoRound);
+    callRequest.caller = &nextPlayer();
+    CallType call = co_await callRequest;
+    if (call != CallType::Pass) {
+      resolveCall(*callRequest.caller, call);
+      co_return;
+    }
+
+    updateCurrentPlayerIndex();
+  }
+}
+
+void Game::beginGame() {
+  updatePalificoRound();
+  lastOutcome = GameOutcome{};
+  lastOutcome.numPlayers = static_cast<int>(players.size());
+  diceInPlay = 0;
+  for (const auto& player : players) {
+    diceInPlay += static_cast<int>(player.GetDice().size());
+  }
+
+  if (eventLog) {
+    eventLog->BeginGame(static_cast<int>(players.size()));
+    if (rules->variant != RuleVariant{}) {
+      eventLog->Rules(rules->variant.Index());
+    }
+    if (config->faces != Dice::kDefaultFaces) {
+      eventLog->Faces(config->faces);
+    }
+    for (const auto& player : players) {
+      eventLog->Roll(player.GetPlayerId(), player.GetDice());
+    }
+  }
+}
+
+std::string Game::applyGuess(const Player& player, const Guess& guess) {
+  TRACE_SPAN(Validate);
+  std::string validationError = ValidateGuess(guess, lastGuess);
+
+  if (eventLog) {
+    eventLog->Bid(player.GetPlayerId(), guess.diceCount, guess.diceValue, validationError.empty());
+  }
+
+  if (!validationError.empty()) {
+    ++lastOutcome.rejectedBids;
+    return validationError;
   }
+
+  lastGuess = guess;
+  ++lastOutcome.bids;
+  lastOutcome.guessingPlayerId = player.GetPlayerId();
+  return validationError;
+}
+
+std::string Game::resolveCall(const Player& caller, CallType call) {
+  TRACE_SPAN(Resolve);
+  // Decision sources only offer the calls of the rule variant; anything else counts as a liar call
+  if (!rules->isAllowedCall(call)) {
+    call = CallType::Liar;
+  }
+  std::string winner = CheckGuessAgainstDice(lastGuess, call);
+  recordOutcome(caller.GetPlayerId(), call, winner);
+  if (eventLog) {
+    if (call == CallType::SpotOn) {
+      eventLog->SpotOnCall(caller.GetPlayerId());
+    } else {
+      eventLog->LiarCall(caller.GetPlayerId());
+    }
+    eventLog->Resolution(winner == GUESSING_PLAYER);
+  }
+  return winner;
 }
 
-void Game::displayCurrentState(Player& currentPlayer) const {
-  std::cout << "PLAYER " << currentPlayer.GetPlayerId() << "'s Turn:\n";
+void Game::displayCurrentState(const Player& currentPlayer) {
+  screen << "PLAYER " << currentPlayer.GetPlayerId() << "'s Turn:\n";
   if (lastGuess.diceCount != 0 || lastGuess.diceValue != 0) {
-    std::cout << "Last Guess: " << lastGuess.diceCount << ", " << lastGuess.diceValue << '\n';
+    screen << "Last Guess: " << lastGuess.diceCount << ", " << lastGuess.diceValue << '\n';
   }
-  std::cout << "Your Dice: ";
-  currentPlayer.DisplayDice();
-  std::cout << '\n';
+  screen << "Your Dice: ";
+  currentPlayer.DisplayDice(screen);
+  screen << '\n';
+}
+
+Player& Game::nextPlayer() {
+  return players[(currentPlayerIndex + 1) % players.size()];
 }
 
 void Game::updateCurrentPlayerIndex() {
@@ -124,12 +296,22 @@ void Game::updateCurrentPlayerIndex() {
 }
 
 std::string Game::ValidateGuess(const Guess& new_guess, const Guess& last_guess) {
+  // The rule variant decides; only pay for building the error message when the guess is invalid
+  if (rules->isValidRaise(new_guess, last_guess, palificoRound)) {
+    return "";
+  }
+
   std::stringstream errorMsg;
 
   if (last_guess.diceCount != 0 || last_guess.diceValue != 0) {
     errorMsg << "Last guess was (" << last_guess.diceCount << ", " << last_guess.diceValue << ")\n";
   }
 
+  if (palificoRound && (new_guess.diceCount > last_guess.diceCount || new_guess.diceValue > last_guess.diceValue)) {
+    errorMsg << INVALID_GUESS_MSG_PALIFICO;
+    return errorMsg.str();
+  }
+
   if (new_guess.diceCount < last_guess.diceCount && new_guess.diceValue <= last_guess.diceValue) {
     errorMsg << INVALID_GUESS_MSG_DICE_COUNT;
     return errorMsg.str();
@@ -149,14 +331,20 @@ std::string Game::ValidateGuess(const Guess& new_guess, const Guess& last_guess)
 }
 
 
-std::string Game::CheckGuessAgainstDice(const Guess& last_guess) {
-  int counter = 0;
-  for (const auto& player : players) {
-    for (const auto& die : player.GetDice()) {
-      if (die.GetFaceValue() == last_guess.diceValue) {
-        ++counter;
-      }
-    }
-  }
-  return (counter >= last_guess.diceCount) ? "Guessing Player" : "Calling Player";
+std::string Game::CheckGuessAgainstDice(const Guess& last_guess, CallType call) {
+  int counter = countMatchingDice(last_guess.diceValue);
+  return rules->guesserWins(call, counter, last_guess.diceCount) ? GUESSING_PLAYER : CALLING_PLAYER;
+}
+
+int Game::countMatchingDice(int dice_value) const {
+  return rules->countMatching(players, dice_value, palificoRound);
+}
+
+void Game::recordOutcome(int calling_player_id, CallType call, const std::string& winner) {
+  lastOutcome.finalDiceCount = lastGuess.diceCount;
+  lastOutcome.finalDiceValue = lastGuess.diceValue;
+  lastOutcome.actualCount = countMatchingDice(lastGuess.diceValue);
+  lastOutcome.callingPlayerId = calling_player_id;
+  lastOutcome.call = call;
+  lastOutcome.guesserWon = (winner == GUESSING_PLAYER);
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the config file parser.
+//
+
+#include "GameConfig.hpp"
+#include "EmbeddedAssets.hpp"
+#include "FileException.hpp"
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+
+std::string ReadWholeFile(const std::filesystem::path& path) {
+  std::ifstream file_handle(path, std::ios::binary);
+  if (!file_handle) {
+    throw FileException("Could not open " + path.string());
+  }
+  std::ostringstream contents;
+  contents << file_handle.rdbuf();
+  return contents.str();
+}
+
+std::string_view Trim(std::string_view text) {
+  auto first = text.find_first_not_of(" \t\r");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// Parses a whole value as an integer in [min, max]
+bool ParseInteger(std::string_view value, int min, int max, int& result) {
+  auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+  return error == std::errc() && end == value.data() + value.size() && result >= min && result <= max;
+}
+
+// Parses config text; 'source' names it in errors. The rules_text value is left in 'rules_text_file'.
+GameConfig ParseGameConfig(std::string_view contents, const std::string& source, std::string& rules_text_file) {
+  GameConfig config;
+  config.rulesText = kEmbeddedRulesText;
+
+  std::string_view remaining = contents;
+  for (int lineNumber = 1; !remaining.empty(); ++lineNumber) {
+    std::size_t newline = remaining.find('\n');
+    std::string_view line = remaining.substr(0, newline);
+    remaining = newline == std::string_view::npos ? std::string_view() : remaining.substr(newline + 1);
+
+    line = Trim(line.substr(0, line.find('#')));
+    if (line.empty()) {
+      continue;
+    }
+    auto error = [&](const std::string& what) {
+      return FileException(source + ':' + std::to_string(lineNumber) + ": " + what);
+    };
+
+    std::size_t equals = line.find('=');
+    if (equals == std::string_view::npos) {
+      throw error("expected key = value");
+    }
+    std::string_view key = Trim(line.substr(0, equals));
+    std::string_view value = Trim(line.substr(equals + 1));
+
+    int number = 0;
+    if (key == "dice_per_player") {
+      if (!ParseInteger(value, 1, 255, number)) {
+        throw error("dice_per_player must be between 1 and 255");
+      }
+      config.dicePerPlayer = number;
+    } else if (key == "faces") {
+      if (!ParseInteger(value, 2, GameConfig::kMaxFaces, number)) {
+        throw error("faces must be between 2 and " + std::to_string(GameConfig::kMaxFaces));
+      }
+      config.faces = static_cast<unsigned>(number);
+    } else if (key == "rules") {
+      auto rules = ParseRuleVariant(value);
+      if (!rules) {
+        throw error("unknown rule variant in '" + std::string(value) + "'");
+      }
+      config.rules = *rules;
+    } else if (key == "rules_text") {
+      rules_text_file = value;
+    } else {
+      throw error("unknown key '" + std::string(key) + "'");
+    }
+  }
+  return config;
+}
+
+} // namespace
+
+GameConfig LoadGameConfig(const std::string& filename) {
+  std::string rulesTextFile;
+  GameConfig config = ParseGameConfig(ReadWholeFile(filename), filename, rulesTextFile);
+  if (!rulesTextFile.empty()) {
+    config.rulesText = ReadWholeFile(std::filesystem::path(filename).parent_path() / rulesTextFile);
+  }
+  return config;
+}
+
+const std::shared_ptr<const GameConfig>& DefaultGameConfig() {
+  // The embedded config names the embedded rules text, which ParseGameConfig starts from anyway
+  static const auto config = [] {
+    std::string rulesTextFile;
+    return std::make_shared<const GameConfig>(ParseGameConfig(kEmbeddedGameConfig, "built-in game.cfg", rulesTextFile));
+  }();
+  return config;
+}
@@ -0,0 +1,159 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the ReplayVerifier class.
+//
+
+#include "ReplayVerifier.hpp"
+#include "CustomException.hpp"
+#include "FileException.hpp"
+#include "GameLogicException.hpp"
+#include <chrono>
+#include <iostream>
+
+ReplayReport ReplayVerifier::Verify(const ReplayReader& reader) {
+  ReplayReport report;
+  for (const auto& block : reader.Blocks()) {
+    VerifyBlock(block, report);
+  }
+  return report;
+}
+
+void ReplayVerifier::VerifyBlock(const EventBlock& block, ReplayReport& report) {
+  EventCursor cursor(block);
+  ReplayEvent event;
+  Guess lastGuess({0, 0});
+  bool inGame = false;
+  bool liarCalled = false;
+  CallType call = CallType::Liar;
+  RuleVariant rules;
+
+  try {
+    while (cursor.Next(event)) {
+      ++report.events;
+      switch (event.type) {
+        case EventType::GameStart:
+          if (inGame) {
+            ++report.gamesIncomplete;
+          }
+          useFaces(Dice::kDefaultFaces, {});
+          game.ResetTable(event.numPlayers);
+          game.SetRules({});
+          rules = {};
+          lastGuess = Guess({0, 0});
+          inGame = true;
+          liarCalled = false;
+          break;
+        case EventType::Rules:
+          if (event.ruleVariant >= kRuleVariantCount) {
+            recordMismatch(report, block, "unknown rule variant " + std::to_string(event.ruleVariant));
+          }
+          rules = RuleVariant::FromIndex(event.ruleVariant % kRuleVariantCount);
+          game.SetRules(rules);
+          break;
+        case EventType::Faces:
+          if (event.dieFaces < 2 || event.dieFaces > GameConfig::kMaxFaces) {
+            recordMismatch(report, block, "unsupported faces per die " + std::to_string(event.dieFaces));
+            return;
+          }
+          useFaces(event.dieFaces, rules);
+          break;
+        case EventType::Roll:
+          game.SetPlayerDice(event.playerId, event.faces);
+          break;
+        case EventType::Bid:
+        case EventType::RejectedBid: {
+          auto guess = Guess({event.diceCount, event.diceValue});
+          bool valid = game.ValidateGuess(guess, lastGuess).empty();
+          if (valid != (event.type == EventType::Bid)) {
+            recordMismatch(report, block, valid ? "valid bid was recorded as rejected"
+                                                : "invalid bid was recorded as accepted");
+          }
+          if (event.type == EventType::Bid) {
+            lastGuess = guess;
+          }
+          break;
+        }
+        case EventType::LiarCall:
+        case EventType::SpotOnCall:
+          liarCalled = true;
+          call = event.type == EventType::SpotOnCall ? CallType::SpotOn : CallType::Liar;
+          break;
+        case EventType::Resolution: {
+          bool guesserWon = game.CheckGuessAgainstDice(lastGuess, call) == GUESSING_PLAYER;
+          if (!inGame || !liarCalled) {
+            recordMismatch(report, block, "resolution without a liar call");
+          } else if (guesserWon != event.guesserWon) {
+            recordMismatch(report, block, "recorded winner differs from the dice");
+          }
+          ++report.gamesVerified;
+          inGame = false;
+          break;
+        }
+      }
+    }
+  } catch (const FileException& e) {
+    recordMismatch(report, block, e.what());
+    return;
+  } catch (const GameLogicException& e) {
+    recordMismatch(report, block, e.what());
+    return;
+  }
+
+  if (inGame) {
+    ++report.gamesIncomplete;
+  }
+}
+
+void ReplayVerifier::useFaces(unsigned faces, const RuleVariant& rules) {
+  if (game.GetConfig().faces == faces) {
+    return;
+  }
+  auto& config = faceConfigs[faces];
+  if (!config) {
+    auto faceConfig = std::make_shared<GameConfig>(*DefaultGameConfig());
+    faceConfig->faces = faces;
+    config = std::move(faceConfig);
+  }
+  int players = game.GetPlayerCount();
+  game.SetConfig(config);
+  game.ResetTable(players);
+  game.SetRules(rules);
+}
+
+void ReplayVerifier::recordMismatch(ReplayReport& report, const EventBlock& block, const std::string& what) {
+  ++report.mismatches;
+  if (report.mismatchDetails.size() < kMaxReportedMismatches) {
+    report.mismatchDetails.push_back("block at offset " + std::to_string(block.fileOffset) + ": " + what);
+  }
+}
+
+int RunReplayVerification(const std::string& filename) {
+  try {
+    auto start = std::chrono::steady_clock::now();
+    ReplayReader reader(filename);
+    ReplayVerifier verifier;
+    ReplayReport report = verifier.Verify(reader);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Replayed " << report.gamesVerified << " games (" << report.events << " events, "
+              << reader.SizeBytes() << " bytes) in " << elapsed.count() << " s";
+    if (elapsed.count() > 0) {
+      std::cout << " (" << static_cast<double>(reader.SizeBytes()) / elapsed.count() / 1e6 << " MB/s)";
+    }
+    std::cout << '\n';
+    if (reader.TruncatedBytes() != 0) {
+      std::cout << "Ignored " << reader.TruncatedBytes() << " bytes of a truncated final block\n";
+    }
+    if (report.gamesIncomplete != 0) {
+      std::cout << report.gamesIncomplete << " games ended without a resolution\n";
+    }
+    for (const auto& detail : report.mismatchDetails) {
+      std::cout << "Mismatch: " << detail << '\n';
+    }
+    std::cout << (report.Passed() ? "All games verified\n" : std::to_string(report.mismatches) + " mismatches\n");
+    return report.Passed() ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
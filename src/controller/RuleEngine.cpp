@@ -0,0 +1,66 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the table of RuleEngine instantiations.
+//
+
+#include "RuleEngine.hpp"
+#include <array>
+#include <utility>
+
+namespace {
+
+template <RuleVariant Rules>
+constexpr RuleTable MakeRuleTable() {
+  using Engine = RuleEngine<Rules>;
+  return {Rules, &Engine::IsValidRaise, &Engine::CountMatching, &Engine::IsAllowedCall, &Engine::GuesserWins};
+}
+
+template <std::size_t... Index>
+constexpr std::array<RuleTable, sizeof...(Index)> MakeRuleTables(std::index_sequence<Index...>) {
+  return {MakeRuleTable<RuleVariant::FromIndex(Index)>()...};
+}
+
+constexpr auto RULE_TABLES = MakeRuleTables(std::make_index_sequence<kRuleVariantCount>());
+
+constexpr std::string_view CLASSIC = "classic";
+constexpr std::string_view WILD_ONES = "wild-ones";
+constexpr std::string_view SPOT_ON = "spot-on";
+constexpr std::string_view PALIFICO = "palifico";
+
+} // namespace
+
+const RuleTable& SelectRules(RuleVariant variant) {
+  return RULE_TABLES[variant.Index()];
+}
+
+std::optional<RuleVariant> ParseRuleVariant(std::string_view names) {
+  RuleVariant variant;
+  while (!names.empty()) {
+    std::size_t comma = names.find(',');
+    std::string_view name = names.substr(0, comma);
+    names = comma == std::string_view::npos ? std::string_view() : names.substr(comma + 1);
+
+    if (name == WILD_ONES) {
+      variant.wildOnes = true;
+    } else if (name == SPOT_ON) {
+      variant.spotOn = true;
+    } else if (name == PALIFICO) {
+      variant.palifico = true;
+    } else if (name != CLASSIC) {
+      return std::nullopt;
+    }
+  }
+  return variant;
+}
+
+std::string DescribeRuleVariant(RuleVariant variant) {
+  std::string names;
+  for (auto [enabled, name] : {std::pair{variant.wildOnes, WILD_ONES}, std::pair{variant.spotOn, SPOT_ON},
+                               std::pair{variant.palifico, PALIFICO}}) {
+    if (enabled) {
+      names += names.empty() ? "" : ",";
+      names += name;
+    }
+  }
+  return names.empty() ? std::string(CLASSIC) : names;
+}
@@ -0,0 +1,86 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the bot-only simulation.
+//
+
+#include "Simulation.hpp"
+#include "BotDecisions.hpp"
+#include "ColumnStore.hpp"
+#include "CustomException.hpp"
+#include "EventLog.hpp"
+#include "Game.hpp"
+#include "TableScheduler.hpp"
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Each table keeps its own event log buffer: games of different tables interleave on the thread
+constexpr std::size_t TABLE_LOG_BLOCK_SIZE = 16 * 1024;
+
+struct SimulatedTable {
+  Game game;
+  BotDecisions bots;
+  std::unique_ptr<EventLogWriter> eventLog;
+
+  SimulatedTable(std::uint32_t seed, std::chrono::microseconds think_time,
+                 const std::shared_ptr<const GameConfig>& config)
+      : bots(seed, think_time, static_cast<int>(config->faces), config->rules) {
+    game.SetConfig(config);
+  }
+};
+
+} // namespace
+
+SimulationResult Simulate(const SimulationOptions& options, EventLog* event_log, ColumnarWriter* columns) {
+  Dice::Seed(options.seed);
+  TableScheduler scheduler;
+  std::vector<std::unique_ptr<SimulatedTable>> tables;
+  std::uint64_t started = 0;
+  std::uint64_t finished = 0;
+
+  std::function<void(SimulatedTable&)> startNextGame = [&](SimulatedTable& table) {
+    if (started == options.games) {
+      return;
+    }
+    ++started;
+    table.game.ResetTable(options.players);
+    table.game.RollDice();
+    scheduler.Spawn(table.game.PlayGameAsync(table.bots), [&] {
+      ++finished;
+      if (columns) {
+        columns->Append(table.game.GetLastOutcome());
+      }
+      startNextGame(table);
+    });
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < options.tables; ++i) {
+    auto& table =
+        *tables.emplace_back(std::make_unique<SimulatedTable>(options.seed + i, options.thinkTime, options.config));
+    if (event_log) {
+      table.eventLog = std::make_unique<EventLogWriter>(*event_log, TABLE_LOG_BLOCK_SIZE);
+      table.game.SetEventLog(table.eventLog.get());
+    }
+    startNextGame(table);
+  }
+  scheduler.Run();
+
+  return {finished, std::chrono::steady_clock::now() - start};
+}
+
+int RunSimulation(const SimulationOptions& options, EventLog* event_log, ColumnarWriter* columns) {
+  try {
+    SimulationResult result = Simulate(options, event_log, columns);
+    std::cout << "Simulated " << result.games << " games on " << options.tables << " tables in "
+              << result.elapsed.count() << " s (" << static_cast<double>(result.games) / result.elapsed.count()
+              << " games/s)\n";
+    return EXIT_SUCCESS;
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,79 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the TableScheduler class.
+//
+
+#include "TableScheduler.hpp"
+#include "GameLogicException.hpp"
+#include <thread>
+
+void TableScheduler::Spawn(GameTask task, std::function<void()> on_finished) {
+  GameTask::Handle handle = task.Release();
+  handle.promise().scheduler = this;
+  handle.promise().onFinished = std::move(on_finished);
+  ++activeTasks;
+  Post(handle);
+}
+
+void TableScheduler::PostAt(Clock::time_point when, std::coroutine_handle<> handle) {
+  timers.push({when, timerSequence++, handle});
+}
+
+void TableScheduler::Run() {
+  while (activeTasks > 0) {
+    RunReady();
+    if (activeTasks == 0) {
+      break;
+    }
+    if (timers.empty()) {
+      // Every remaining table waits on a decision nobody is going to deliver
+      throw GameLogicException("All tables are waiting but no decision is pending");
+    }
+    std::this_thread::sleep_until(timers.top().when);
+  }
+
+  if (firstError) {
+    std::rethrow_exception(std::exchange(firstError, nullptr));
+  }
+}
+
+void TableScheduler::RunReady() {
+  Clock::time_point now = Clock::now();
+  while (!timers.empty() && timers.top().when <= now) {
+    ready.push_back(timers.top().handle);
+    timers.pop();
+  }
+
+  while (!ready.empty()) {
+    std::coroutine_handle<> handle = ready.front();
+    ready.pop_front();
+    handle.resume();
+  }
+}
+
+std::optional<TableScheduler::Clock::time_point> TableScheduler::NextDeadline() const {
+  if (timers.empty()) {
+    return std::nullopt;
+  }
+  return timers.top().when;
+}
+
+void TableScheduler::finish(GameTask::Handle handle) noexcept {
+  std::function<void()> on_finished = std::move(handle.promise().onFinished);
+  if (handle.promise().exception && !firstError) {
+    firstError = handle.promise().exception;
+  }
+  // Destroying the frame from its own final suspend point is allowed; nothing touches it afterwards
+  handle.destroy();
+  --activeTasks;
+
+  if (on_finished) {
+    try {
+      on_finished();
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+}
@@ -0,0 +1,199 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the per-thread perf_event counter groups and the phase report.
+//
+
+#include "PerfCounters.hpp"
+
+#ifdef LIARSDICE_PERF_COUNTERS
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <linux/perf_event.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct CounterEvent {
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+// In PerfCounter order; cycles leads the group
+constexpr std::array<CounterEvent, kPerfCounterCount> COUNTER_EVENTS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+struct PhaseCounts {
+  std::uint64_t spans = 0;
+  PerfCounterValues counts{};
+};
+
+// One thread's counter group and totals
+struct ThreadCounters {
+  std::array<int, kPerfCounterCount> fds;
+  bool open = false;
+  bool multiplexed = false;  // The group was not always on the PMU; counts are partial
+  std::array<PhaseCounts, kTracePhaseNames.size()> phases;
+
+  ThreadCounters() { fds.fill(-1); }
+};
+
+// Totals outlive their threads so finished threads are still reported
+struct CounterRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadCounters>> threads;
+  std::string unavailable;  // Why the counters could not be opened, if they could not
+};
+
+CounterRegistry& Registry() {
+  // Never destroyed: the report may be written by an exit handler, after static objects are gone
+  static auto* registry = new CounterRegistry;
+  return *registry;
+}
+
+int OpenCounter(const CounterEvent& event, int group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // The calling thread on any CPU
+  return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+std::string PerfEventParanoid() {
+  std::ifstream file("/proc/sys/kernel/perf_event_paranoid");
+  std::string level;
+  return file >> level ? level : "unknown";
+}
+
+ThreadCounters* RegisterThread() {
+  auto counters = std::make_unique<ThreadCounters>();
+  for (std::size_t i = 0; i < kPerfCounterCount; ++i) {
+    counters->fds[i] = OpenCounter(COUNTER_EVENTS[i], i == 0 ? -1 : counters->fds[0]);
+    if (counters->fds[i] < 0) {
+      std::string reason = std::strerror(errno);
+      for (int fd : counters->fds) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+      }
+      counters->fds.fill(-1);
+      CounterRegistry& registry = Registry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.unavailable = reason + " (perf_event_paranoid " + PerfEventParanoid() + ")";
+      return registry.threads.emplace_back(std::move(counters)).get();
+    }
+  }
+  counters->open = true;
+  ::ioctl(counters->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ::ioctl(counters->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+  CounterRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.threads.emplace_back(std::move(counters)).get();
+}
+
+ThreadCounters& CurrentThread() {
+  thread_local ThreadCounters* counters = RegisterThread();
+  return *counters;
+}
+
+double Ratio(std::uint64_t numerator, std::uint64_t denominator, double scale = 1) {
+  return denominator == 0 ? 0 : static_cast<double>(numerator) * scale / static_cast<double>(denominator);
+}
+
+} // namespace
+
+bool ReadPerfCounters(PerfCounterValues& values) {
+  ThreadCounters& counters = CurrentThread();
+  if (!counters.open) {
+    return false;
+  }
+  // PERF_FORMAT_GROUP with both times: nr, time enabled, time running, one value per counter
+  std::array<std::uint64_t, 3 + kPerfCounterCount> data;
+  if (::read(counters.fds[0], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) ||
+      data[0] != kPerfCounterCount) {
+    return false;
+  }
+  if (data[2] < data[1]) {
+    counters.multiplexed = true;
+  }
+  std::copy(data.begin() + 3, data.end(), values.begin());
+  return true;
+}
+
+void AddPhaseCounts(TracePhase phase, const PerfCounterValues& start, const PerfCounterValues& end) {
+  // Only the owning thread writes its totals; the report reads them under the registry lock at exit
+  PhaseCounts& totals = CurrentThread().phases[static_cast<std::size_t>(phase)];
+  ++totals.spans;
+  for (std::size_t i = 0; i < kPerfCounterCount; ++i) {
+    totals.counts[i] += end[i] - start[i];
+  }
+}
+
+void WritePhaseCounters(std::ostream& out) {
+  CounterRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (!registry.unavailable.empty()) {
+    out << "Performance counters unavailable: " << registry.unavailable << '\n';
+    return;
+  }
+
+  std::array<PhaseCounts, kTracePhaseNames.size()> phases{};
+  bool multiplexed = false;
+  for (const auto& thread : registry.threads) {
+    multiplexed |= thread->multiplexed;
+    for (std::size_t p = 0; p < phases.size(); ++p) {
+      phases[p].spans += thread->phases[p].spans;
+      for (std::size_t i = 0; i < kPerfCounterCount; ++i) {
+        phases[p].counts[i] += thread->phases[p].counts[i];
+      }
+    }
+  }
+
+  auto count = [](const PhaseCounts& phase, PerfCounter counter) {
+    return phase.counts[static_cast<std::size_t>(counter)];
+  };
+  out << "Performance counters per phase (user space, nested phases included)\n"
+      << std::left << std::setw(10) << "phase" << std::right << std::setw(12) << "spans" << std::setw(14)
+      << "cycles/span" << std::setw(8) << "IPC" << std::setw(14) << "cache miss %" << std::setw(12) << "cache MPKI"
+      << std::setw(15) << "branch miss %" << std::setw(13) << "branch MPKI" << '\n'
+      << std::fixed << std::setprecision(2);
+  for (std::size_t p = 0; p < phases.size(); ++p) {
+    const PhaseCounts& phase = phases[p];
+    if (phase.spans == 0) {
+      continue;
+    }
+    std::uint64_t instructions = count(phase, PerfCounter::Instructions);
+    out << std::left << std::setw(10) << kTracePhaseNames[p] << std::right << std::setw(12) << phase.spans
+        << std::setw(14) << Ratio(count(phase, PerfCounter::Cycles), phase.spans) << std::setw(8)
+        << Ratio(instructions, count(phase, PerfCounter::Cycles)) << std::setw(14)
+        << Ratio(count(phase, PerfCounter::CacheMisses), count(phase, PerfCounter::CacheReferences), 100)
+        << std::setw(12) << Ratio(count(phase, PerfCounter::CacheMisses), instructions, 1000) << std::setw(15)
+        << Ratio(count(phase, PerfCounter::BranchMisses), count(phase, PerfCounter::Branches), 100)
+        << std::setw(13) << Ratio(count(phase, PerfCounter::BranchMisses), instructions, 1000) << '\n';
+  }
+  if (multiplexed) {
+    out << "(the counter group did not always fit on the PMU, so some spans were only partly counted)\n";
+  }
+}
+
+#endif
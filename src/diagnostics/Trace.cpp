@@ -0,0 +1,87 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the trace buffer registry and the Chrome trace-event writer.
+//
+
+#include "Trace.hpp"
+
+#ifdef LIARSDICE_TRACING
+
+#include "FileException.hpp"
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Buffers outlive their threads so spans of finished threads can still be written
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers;
+  // Pairs ticks with the steady clock to convert the ticks of every event to microseconds
+  std::uint64_t originTicks = ReadTraceTicks();
+  std::chrono::steady_clock::time_point originTime = std::chrono::steady_clock::now();
+};
+
+TraceRegistry& Registry() {
+  // Never destroyed: the trace may be written by an exit handler, after static objects are gone
+  static auto* registry = new TraceRegistry;
+  return *registry;
+}
+
+// Fixes the time origin at startup, before any span can open; a registry made lazily by the first
+// span to close would put that span's start before the origin
+[[maybe_unused]] const TraceRegistry& registryAtStartup = Registry();
+
+} // namespace
+
+TraceBuffer* RegisterTraceBuffer() {
+  TraceRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& buffer = registry.buffers.emplace_back(std::make_unique<TraceBuffer>());
+  buffer->threadId = static_cast<int>(registry.buffers.size());
+  return buffer.get();
+}
+
+void WriteTrace(std::ostream& out) {
+  TraceRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::uint64_t ticks = ReadTraceTicks() - registry.originTicks;
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - registry.originTime;
+  double ticksPerMicrosecond = elapsed.count() > 0 ? static_cast<double>(ticks) / elapsed.count() : 1;
+  auto microseconds = [&](std::uint64_t tick) {
+    return static_cast<double>(static_cast<std::int64_t>(tick - registry.originTicks)) / ticksPerMicrosecond;
+  };
+
+  out << std::fixed << std::setprecision(3);  // Nanosecond resolution
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& buffer : registry.buffers) {
+    std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+    std::uint64_t first = written > kTraceBufferEvents ? written - kTraceBufferEvents : 0;
+    for (std::uint64_t i = first; i < written; ++i) {
+      const TraceEvent& event = buffer->events[i & (kTraceBufferEvents - 1)];
+      out << separator << "{\"name\":\"" << kTracePhaseNames[static_cast<std::size_t>(event.phase)]
+          << "\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+          << ",\"ts\":" << microseconds(event.start) << ",\"dur\":" << microseconds(event.end) - microseconds(event.start)
+          << '}';
+      separator = ",\n";
+    }
+  }
+  out << "\n]}\n";
+}
+
+void WriteTraceFile(const std::string& path) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    throw FileException("Could not open trace file " + path);
+  }
+  WriteTrace(file);
+  if (!file) {
+    throw FileException("Could not write trace file " + path);
+  }
+}
+
+#endif
@@ -0,0 +1,113 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the bid parser.
+//
+
+#include "BidParser.hpp"
+#include <array>
+#include <charconv>
+
+namespace {
+
+// Index = value; "zero" only keeps the table aligned, ParseBid rejects it
+constexpr std::array<std::string_view, 21> NUMBER_WORDS = {
+    "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine", "ten",
+    "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen", "seventeen", "eighteen", "nineteen", "twenty",
+};
+
+constexpr bool IsBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+constexpr bool IsLetter(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+constexpr char ToLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+void SkipBlanks(std::string_view& text) {
+  while (!text.empty() && IsBlank(text.front())) {
+    text.remove_prefix(1);
+  }
+}
+
+bool EqualsIgnoreCase(std::string_view word, std::string_view lower) {
+  if (word.size() != lower.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    if (ToLower(word[i]) != lower[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Matches a number word, optionally in the plural ("fours", "sixes") when it names a face
+std::optional<int> MatchWord(std::string_view word, bool allow_plural) {
+  for (std::size_t value = 0; value < NUMBER_WORDS.size(); ++value) {
+    std::string_view number = NUMBER_WORDS[value];
+    if (EqualsIgnoreCase(word, number)) {
+      return static_cast<int>(value);
+    }
+    if (allow_plural && word.size() > number.size() && EqualsIgnoreCase(word.substr(0, number.size()), number)) {
+      std::string_view suffix = word.substr(number.size());
+      if (EqualsIgnoreCase(suffix, number.back() == 'x' ? "es" : "s")) {
+        return static_cast<int>(value);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// Reads one number, in digits or in words, from the front of 'text'
+std::optional<int> ReadNumber(std::string_view& text, bool allow_plural) {
+  if (text.empty()) {
+    return std::nullopt;
+  }
+  if (IsLetter(text.front())) {
+    std::size_t length = 0;
+    while (length < text.size() && IsLetter(text[length])) {
+      ++length;
+    }
+    auto value = MatchWord(text.substr(0, length), allow_plural);
+    text.remove_prefix(length);
+    return value;
+  }
+  int value = 0;
+  auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc()) {
+    return std::nullopt;
+  }
+  text.remove_prefix(static_cast<std::size_t>(end - text.data()));
+  return value;
+}
+
+} // namespace
+
+std::optional<std::pair<int, int>> ParseBid(std::string_view text) {
+  SkipBlanks(text);
+  auto quantity = ReadNumber(text, false);
+  if (!quantity) {
+    return std::nullopt;
+  }
+
+  // The two numbers are separated by a comma, blanks, or both
+  std::size_t before = text.size();
+  SkipBlanks(text);
+  if (!text.empty() && text.front() == ',') {
+    text.remove_prefix(1);
+    SkipBlanks(text);
+  } else if (text.size() == before) {
+    return std::nullopt;  // "34" or "3four"
+  }
+
+  auto face_value = ReadNumber(text, true);
+  SkipBlanks(text);
+  if (!face_value || !text.empty() || *quantity < 1 || *face_value < 1) {
+    return std::nullopt;
+  }
+  return std::pair{*quantity, *face_value};
+}
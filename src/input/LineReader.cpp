@@ -0,0 +1,157 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the console and script readers.
+//
+
+#include "LineReader.hpp"
+#include "ConsoleOutput.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t READ_CHUNK_SIZE = 4096;
+
+void DropCarriageReturn(std::string& line) {
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();  // Windows line break
+  }
+}
+
+bool GetLine(std::istream& in, std::string& line) {
+  if (!std::getline(in, line)) {
+    return false;
+  }
+  DropCarriageReturn(line);
+  return true;
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+ReadStatus ConsoleReader::ReadLine(std::string_view prompt, std::string& line, Clock::time_point) {
+  std::cout << prompt;
+  FlushConsoleOutput();
+  return GetLine(std::cin, line) ? ReadStatus::Line : ReadStatus::End;
+}
+
+#else
+
+ReadStatus ConsoleReader::ReadLine(std::string_view prompt, std::string& line, Clock::time_point deadline) {
+  std::cout << prompt;
+  if (takeLine(line)) {
+    return ReadStatus::Line;  // Typed ahead; the prompt goes out with the next flush
+  }
+  std::cout.flush();  // The player has to see the prompt before answering it
+
+  Clock::time_point nextIdle = idleHook ? Clock::now() + idleInterval : kNoDeadline;
+  while (!ended) {
+    Clock::time_point now = Clock::now();
+    if (now >= deadline) {
+      // Whatever the player has started typing answers a question that is gone
+      if (::isatty(fd)) {
+        ::tcflush(fd, TCIFLUSH);
+      }
+      buffer.clear();
+      consumed = 0;
+      return ReadStatus::TimedOut;
+    }
+    if (now >= nextIdle) {
+      idleHook();
+      nextIdle = Clock::now() + idleInterval;
+      continue;
+    }
+
+    Clock::time_point wake = std::min(deadline, nextIdle);
+    int timeout = -1;
+    if (wake != kNoDeadline) {
+      auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now).count();
+      timeout = static_cast<int>(std::min<decltype(wait)>(wait, std::numeric_limits<int>::max()));
+    }
+    pollfd ready{fd, POLLIN, 0};
+    int count = ::poll(&ready, 1, timeout);
+    if (count < 0 && errno != EINTR) {
+      ended = true;
+    } else if (count > 0) {
+      readAvailable();
+      if (takeLine(line)) {
+        return ReadStatus::Line;
+      }
+    }
+  }
+
+  if (consumed == buffer.size()) {
+    return ReadStatus::End;
+  }
+  // The input ended without a final line break
+  line.assign(buffer, consumed);
+  consumed = buffer.size();
+  DropCarriageReturn(line);
+  return ReadStatus::Line;
+}
+
+bool ConsoleReader::takeLine(std::string& line) {
+  std::size_t end = buffer.find('\n', consumed);
+  if (end == std::string::npos) {
+    return false;
+  }
+  line.assign(buffer, consumed, end - consumed);
+  consumed = end + 1;
+  if (consumed == buffer.size()) {
+    buffer.clear();
+    consumed = 0;
+  }
+  DropCarriageReturn(line);
+  return true;
+}
+
+// Called once poll reports the descriptor readable, so the read does not block
+void ConsoleReader::readAvailable() {
+  if (consumed > 0) {
+    buffer.erase(0, consumed);
+    consumed = 0;
+  }
+  std::size_t size = buffer.size();
+  buffer.resize(size + READ_CHUNK_SIZE);
+  ssize_t count = ::read(fd, buffer.data() + size, READ_CHUNK_SIZE);
+  buffer.resize(size + static_cast<std::size_t>(std::max<ssize_t>(count, 0)));
+  if (count == 0 || (count < 0 && errno != EINTR && errno != EAGAIN)) {
+    ended = true;
+  }
+}
+
+#endif
+
+ConsoleReader& ConsoleInput() {
+  static ConsoleReader console;
+  return console;
+}
+
+ScriptReader::ScriptReader(const std::string& path) : script(&std::cin) {
+  if (path != "-") {
+    file.open(path);
+    if (!file) {
+      throw FileException("Unable to open script " + path);
+    }
+    script = &file;
+  }
+}
+
+ReadStatus ScriptReader::ReadLine(std::string_view, std::string& line, Clock::time_point) {
+  while (GetLine(*script, line)) {
+    if (!line.starts_with('#')) {
+      return ReadStatus::Line;
+    }
+  }
+  return ReadStatus::End;
+}
@@ -1,33 +1,285 @@
 #include "Game.hpp"
+#include "EventLog.hpp"
+#include "ReplayVerifier.hpp"
+#include "GameAnalytics.hpp"
+#include "ColumnStore.hpp"
+#include "ConsoleOutput.hpp"
+#include "Simulation.hpp"
+#include "CustomException.hpp"
+#include "FileException.hpp"
+#include "GameConfig.hpp"
+#include "InputException.hpp"
+#include "LineReader.hpp"
+#ifdef LIARSDICE_WITH_SERVER
+#include "GameServer.hpp"
+#endif
+#ifdef LIARSDICE_TRACING
+#include "Trace.hpp"
+#include <cstdlib>
+#endif
+#ifdef LIARSDICE_PERF_COUNTERS
+#include "PerfCounters.hpp"
+#include <cstdlib>
+#endif
+#include <chrono>
 #include <iostream>
-#include <limits>
-
-
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 const std::string PLAY_AGAIN_YES = "yes";
 const std::string WELCOME_MESSAGE = "Welcome to Liar's Dice!\n";
 const std::string GOODBYE_MESSAGE = "Thank you for playing Liar's Dice!\n";
 const std::string PLAY_AGAIN_PROMPT = "Do you want to play again? (yes/no): ";
+constexpr std::chrono::seconds AUTOSAVE_INTERVAL(1);
+const std::string USAGE_MESSAGE =
+    "Usage: LiarsDice [--script <file|->] [--turn-time <seconds>] [--log <event-log-file>]\n"
+    "                 [--columns <export-dir>]\n"
+    "       LiarsDice --simulate <games> [--tables <n>] [--players <n>] [--think-ms <n>] [--seed <n>]\n"
+    "                 [--log <event-log-file>] [--columns <export-dir>]\n"
+    "       LiarsDice --replay <event-log-file>\n"
+    "       LiarsDice --analyze <event-log-file>...\n"
+    "       LiarsDice --server <port> [--loops <n>] [--players <n>] [--watch-port <port>]\n"
+    "                 [--turn-time <seconds>] [--checkpoint <dir>]\n"
+    "       (--checkpoint needs --watch-port: restored seats are resumed through the watch port)\n"
+    "Playing, --simulate and --server accept --config <file> (default: the built-in assets/game.cfg)\n"
+    "and --rules <variants>, a comma-separated list of classic, wild-ones, spot-on and palifico\n"
+#ifdef LIARSDICE_TRACING
+    "and --trace <file>, which writes the turn phases of the run as Chrome trace-event JSON on exit\n"
+#endif
+#ifdef LIARSDICE_PERF_COUNTERS
+    "and --counters, which prints the cycles, IPC, cache and branch misses of each turn phase on exit\n"
+#endif
+    ;
+
+#ifdef LIARSDICE_TRACING
+std::string tracePath;
+
+// Writes the trace of the run however main returns
+void WriteTraceAtExit() {
+  try {
+    WriteTraceFile(tracePath);
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+#endif
+
+#ifdef LIARSDICE_PERF_COUNTERS
+// Prints the counts of the run however main returns
+void WritePhaseCountersAtExit() {
+  WritePhaseCounters(std::cout);
+}
+#endif
+
+// Reads the numeric value following an option; returns false if it is missing or not a number
+bool ReadNumber(int argc, char* argv[], int& i, long long& value) {
+  if (i + 1 >= argc) {
+    return false;
+  }
+  try {
+    value = std::stoll(argv[++i]);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return value >= 0;
+}
 
-int main() {
+int main(int argc, char* argv[]) {
+  BufferConsoleOutput();
   std::string playAgain;
+  std::string eventLogPath;
+  std::string columnsPath;
+  std::string scriptPath;  // Empty: the player at the terminal
+  std::chrono::milliseconds turnTime{0};  // Per bid and liar call; 0 = no limit
+  bool simulate = false;
+  SimulationOptions simulation;
+  std::string configPath;  // Empty: the built-in settings
+  std::optional<RuleVariant> rules;
+#ifdef LIARSDICE_WITH_SERVER
+  bool serve = false;
+  ServerOptions server;
+#endif
+#ifdef LIARSDICE_PERF_COUNTERS
+  bool countPhases = false;
+#endif
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    long long number = 0;
+    bool ok = true;
+    if (arg == "--log" && i + 1 < argc) {
+      eventLogPath = argv[++i];
+    } else if (arg == "--columns" && i + 1 < argc) {
+      columnsPath = argv[++i];
+    } else if (arg == "--script" && i + 1 < argc) {
+      // Answers from a file or pipe instead of the terminal
+      scriptPath = argv[++i];
+    } else if (arg == "--replay" && i + 1 < argc) {
+      // Verify a recorded log instead of playing
+      return RunReplayVerification(argv[++i]);
+    } else if (arg == "--analyze" && i + 1 < argc) {
+      // Aggregate statistics over one or more recorded logs instead of playing
+      return RunAnalytics(std::vector<std::string>(argv + i + 1, argv + argc));
+    } else if (arg == "--rules" && i + 1 < argc && ParseRuleVariant(argv[i + 1])) {
+      rules = ParseRuleVariant(argv[++i]);
+    } else if (arg == "--config" && i + 1 < argc) {
+      configPath = argv[++i];
+    } else if (arg == "--simulate" && ReadNumber(argc, argv, i, number)) {
+      simulate = true;
+      simulation.games = static_cast<std::uint64_t>(number);
+    } else if (arg == "--tables" && ReadNumber(argc, argv, i, number) && number > 0) {
+      simulation.tables = static_cast<int>(number);
+    } else if (arg == "--players" && ReadNumber(argc, argv, i, number) && number > 1) {
+      simulation.players = static_cast<int>(number);
+#ifdef LIARSDICE_WITH_SERVER
+      server.tableSize = simulation.players;
+    } else if (arg == "--server" && ReadNumber(argc, argv, i, number) && number <= 65535) {
+      serve = true;
+      server.port = static_cast<std::uint16_t>(number);
+    } else if (arg == "--loops" && ReadNumber(argc, argv, i, number) && number > 0) {
+      server.loops = static_cast<unsigned>(number);
+    } else if (arg == "--watch-port" && ReadNumber(argc, argv, i, number) && number <= 65535) {
+      server.spectatorPort = static_cast<std::uint16_t>(number);
+    } else if (arg == "--checkpoint" && i + 1 < argc) {
+      server.checkpointDir = argv[++i];
+#endif
+#ifdef LIARSDICE_TRACING
+    } else if (arg == "--trace" && i + 1 < argc) {
+      tracePath = argv[++i];
+#endif
+#ifdef LIARSDICE_PERF_COUNTERS
+    } else if (arg == "--counters") {
+      countPhases = true;
+#endif
+    } else if (arg == "--turn-time" && ReadNumber(argc, argv, i, number) && number <= 24 * 60 * 60) {
+      turnTime = std::chrono::seconds(number);
+    } else if (arg == "--think-ms" && ReadNumber(argc, argv, i, number)) {
+      simulation.thinkTime = std::chrono::milliseconds(number);
+    } else if (arg == "--seed" && ReadNumber(argc, argv, i, number)) {
+      simulation.seed = static_cast<std::uint32_t>(number);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      std::cerr << USAGE_MESSAGE;
+      return EXIT_FAILURE;
+    }
+  }
+
+#ifdef LIARSDICE_TRACING
+  if (!tracePath.empty()) {
+    std::atexit(WriteTraceAtExit);
+  }
+#endif
+#ifdef LIARSDICE_PERF_COUNTERS
+  if (countPhases) {
+    std::atexit(WritePhaseCountersAtExit);
+  }
+#endif
+
+  // Game settings, parsed once and shared read-only by every game and table of this run
+  std::shared_ptr<const GameConfig> config;
+  try {
+    GameConfig settings = configPath.empty() ? *DefaultGameConfig() : LoadGameConfig(configPath);
+    if (rules) {
+      settings.rules = *rules;
+    }
+    config = std::make_shared<const GameConfig>(std::move(settings));
+  } catch (const FileException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef LIARSDICE_WITH_SERVER
+  if (serve) {
+    if (server.tableSize > ServerOptions::kMaxTableSize) {
+      std::cerr << "A server table seats at most " << ServerOptions::kMaxTableSize << " players\n";
+      return EXIT_FAILURE;
+    }
+    if (!server.checkpointDir.empty() && !server.spectatorPort) {
+      // Nobody could Resume a restored seat; every one of them would be played by the server
+      std::cerr << "--checkpoint needs --watch-port: players Resume restored seats through the watch port\n";
+      return EXIT_FAILURE;
+    }
+    // Networked tables instead of the local console game
+    server.config = config;
+    server.turnTime = turnTime;
+    return RunServer(server);
+  }
+#endif
+
+  // Optional binary event log of every game played in this session
+  std::unique_ptr<EventLog> eventLog;
+  std::unique_ptr<EventLogWriter> eventLogWriter;
+  // Optional columnar export of every game's outcome
+  std::unique_ptr<ColumnarWriter> columns;
+  try {
+    if (!eventLogPath.empty()) {
+      eventLog = std::make_unique<EventLog>(eventLogPath);
+      eventLogWriter = std::make_unique<EventLogWriter>(*eventLog);
+    }
+    if (!columnsPath.empty()) {
+      columns = std::make_unique<ColumnarWriter>(columnsPath);
+    }
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (simulate) {
+    // Bot-only tables, all run as coroutines on this thread
+    simulation.config = config;
+    return RunSimulation(simulation, eventLog.get(), columns.get());
+  }
+
+  // Scripted answers, run without prompts or screen redraws
+  std::unique_ptr<ScriptReader> script;
+  if (!scriptPath.empty()) {
+    try {
+      script = std::make_unique<ScriptReader>(scriptPath);
+    } catch (const FileException& e) {
+      std::cerr << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  LineReader& input = script ? static_cast<LineReader&>(*script) : ConsoleInput();
+  if (eventLog) {
+    // Games already finished reach the log file while the player thinks
+    ConsoleInput().SetIdleHook([&] {
+      eventLogWriter->FlushFinishedGames();
+      eventLog->Flush();
+    }, AUTOSAVE_INTERVAL);
+  }
 
   // Display the welcome message
   std::cout << WELCOME_MESSAGE;
 
   // Initialize the game
   Game game;
+  game.SetEventLog(eventLogWriter.get());
+  game.SetConfig(config);
+  game.SetInput(input);
+  game.SetTurnTime(turnTime);
 
   do {
     // Start the game
-    game.Init();
-
-    // Prompt the user to play again
-    std::cout << PLAY_AGAIN_PROMPT;
-    std::cin >> playAgain;
+    try {
+      game.Init();
+    } catch (const InputException& e) {
+      std::cout.flush();
+      std::cerr << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (columns) {
+      columns->Append(game.GetLastOutcome());
+    }
 
-    // Clear the input buffer to ensure proper functioning of cin in the next iteration
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    // Prompt the user to play again; the end of the input means no
+    if (input.ReadLine(PLAY_AGAIN_PROMPT, playAgain) != ReadStatus::Line) {
+      break;
+    }
   } while (playAgain == PLAY_AGAIN_YES);
 
   // Display the goodbye message
@@ -0,0 +1,39 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the binomial tail used to judge how likely a bid is.
+//
+
+#include "BidProbability.hpp"
+#include <algorithm>
+#include <cmath>
+
+double MatchChance(int face, int faces, bool ones_wild) {
+  return (ones_wild && face != 1 ? 2.0 : 1.0) / faces;
+}
+
+double ProbabilityAtLeast(int needed, int unknown_dice, double chance) {
+  if (needed <= 0) {
+    return 1.0;
+  }
+  if (needed > unknown_dice) {
+    return 0.0;
+  }
+  if (chance >= 1.0) {
+    return 1.0;
+  }
+
+  // Sum the binomial tail upwards from 'needed', starting in log space so large tables don't underflow
+  const double p = chance;
+  const double n = unknown_dice;
+  double term = std::exp(std::lgamma(n + 1) - std::lgamma(needed + 1.0) - std::lgamma(n - needed + 1) +
+                         needed * std::log(p) + (n - needed) * std::log1p(-p));
+  double sum = 0;
+  for (int k = needed; k <= unknown_dice; ++k) {
+    sum += term;
+    if (term < sum * 1e-12) {
+      break;
+    }
+    term *= (n - k) / (k + 1.0) * p / (1 - p);
+  }
+  return std::min(sum, 1.0);
+}
@@ -5,14 +5,16 @@
 
 #include "Dice.hpp"
 
-// Constructor initializes the random number generator and rolls the dice
-Dice::Dice() : rd(), gen(rd()), dis(1, 6) {
-  Roll();
+// Rolls the dice using std::mt19937 and std::uniform_int_distribution
+void Dice::Roll(unsigned int faces) {
+  std::uniform_int_distribution<unsigned int> dis(1, faces);
+  face_value = dis(Generator());
 }
 
-// Rolls the dice using std::mt19937 and std::uniform_int_distribution
-void Dice::Roll() {
-  face_value = dis(gen);
+// Returns the calling thread's generator, seeding it on first use
+std::mt19937& Dice::Generator() {
+  thread_local std::mt19937 gen{std::random_device{}()};
+  return gen;
 }
 
 // Returns the current face value of the dice
@@ -4,14 +4,18 @@
 //
 
 #include "Player.hpp"
+#include "BidParser.hpp"
+#include "GameLogicException.hpp"
 #include "InputException.hpp"
+#include "LineReader.hpp"
+#include "TerminalRenderer.hpp"
+#include "Trace.hpp"
 #include <iostream>
-#include <sstream>
+#include <string>
 #include <utility>
-#include <limits>
 
-// Constructor initializes the player ID and reserves space for 5 dice
-Player::Player(int id) : id(id), dice(5) {
+// Constructor initializes the player ID and creates the player's dice
+Player::Player(int id, int dice_count, unsigned int faces) : id(id), dice(dice_count), faces(faces) {
   // Roll the dice initially for the player
   RollDice();
 }
@@ -19,52 +23,76 @@ Player::Player(int id) : id(id), dice(5) {
 // Roll all dice for the player
 void Player::RollDice() {
   for (auto& die : dice) {
-    die.Roll();
+    die.Roll(faces);
+  }
+}
+
+// Replace the player's dice with recorded face values
+void Player::SetDice(std::span<const std::uint8_t> face_values) {
+  for (std::uint8_t value : face_values) {
+    if (value < 1 || value > faces) {
+      throw GameLogicException("Player " + std::to_string(id) + " cannot hold a " + std::to_string(value) +
+                               " on a die with " + std::to_string(faces) + " faces");
+    }
+  }
+  if (dice.size() != face_values.size()) {
+    dice.resize(face_values.size());
+  }
+  for (std::size_t i = 0; i < face_values.size(); ++i) {
+    dice[i].SetFaceValue(face_values[i]);
   }
 }
 
 // Display the face values of the player's dice
-void Player::DisplayDice() {
-  std::cout << "Player " << id << ", your dice are: ";
+void Player::DisplayDice(TerminalRenderer& screen) const {
+  screen << "Player " << id << ", your dice are: ";
   for (const auto& die : dice) {
-    std::cout << die.GetFaceValue() << ' ';
+    screen << die.GetFaceValue() << ' ';
   }
-  std::cout << '\n';
+  screen << '\n';
 }
 
 // Allow the player to make a guess
-std::pair<int, int> Player::MakeGuess() {
-  std::pair<int, int> guess;
+std::optional<std::pair<int, int>> Player::MakeGuess(LineReader& input, bool prompted, Deadline deadline) {
+  TRACE_SPAN(Input);
+  std::string line;
   // Loop until a valid guess is made
   while (true) {
-    std::cout << "Enter your guess in format (quantity, face_value): ";
-    std::string input;
-    std::getline(std::cin, input);
-    std::istringstream iss(input);
-
-    int quantity, face_value;
-    char comma;
+    switch (input.ReadLine(std::exchange(prompted, false) ? "" : kGuessPrompt, line, deadline)) {
+      case ReadStatus::Line:
+        break;
+      case ReadStatus::TimedOut:
+        return std::nullopt;
+      case ReadStatus::End:
+        throw InputException("Input ended while waiting for player " + std::to_string(id) + "'s guess");
+    }
 
     // Validate the input format
-    if (iss >> quantity >> comma >> face_value && comma == ',') {
-      guess = {quantity, face_value};
-      break;
+    if (auto bid = ParseBid(line)) {
+      return bid;
     }
 
-    std::cerr << "Invalid input: " << input << std::endl;
-    std::cerr << "Please try again. Example: 3,4" << std::endl;
-
-    // Clear the input buffer
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::cerr << "Invalid input: " << line << '\n';
+    std::cerr << "Please try again. Example: 3,4 or three fours\n";
   }
-  return guess;
 }
 
 // Allow the player to call "Liar" on another player's guess
-bool Player::CallLiar() {
-  std::cout << "Do you want to call liar? (yes/no) ";
+std::optional<CallType> Player::CallLiar(LineReader& input, bool allow_spot_on, Deadline deadline) {
+  TRACE_SPAN(Input);
   std::string call_liar;
-  std::getline(std::cin, call_liar);
-  return (call_liar == "yes");
+  std::string prompt = "Player " + std::to_string(id) + ", do you want to call liar? " +
+                       (allow_spot_on ? "(yes/no/spot) " : "(yes/no) ");
+  switch (input.ReadLine(prompt, call_liar, deadline)) {
+    case ReadStatus::Line:
+      break;
+    case ReadStatus::TimedOut:
+      return std::nullopt;
+    case ReadStatus::End:
+      throw InputException("Input ended while waiting for player " + std::to_string(id) + "'s liar call");
+  }
+  if (call_liar == "yes") {
+    return CallType::Liar;
+  }
+  return (allow_spot_on && call_liar == "spot") ? CallType::SpotOn : CallType::Pass;
 }
@@ -0,0 +1,199 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the CheckpointFile class.
+//
+
+#include "CheckpointFile.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t FILE_HEADER_SIZE = 64;
+constexpr char MAGIC[8] = {'L', 'D', 'C', 'K', 'P', 'T', '0', '1'};
+constexpr std::uint32_t GROWTH_RECORDS = 4096;  // The file grows by this many records at a time
+
+constexpr std::array<std::uint32_t, 256> MakeCrcTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr auto CRC_TABLE = MakeCrcTable();
+
+std::uint32_t Crc32(const std::uint8_t* data, std::size_t size) {
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+template <typename T>
+T Load(const std::uint8_t* from) {
+  T value;
+  std::memcpy(&value, from, sizeof(value));
+  return value;
+}
+
+template <typename T>
+void Store(std::uint8_t* to, T value) {
+  std::memcpy(to, &value, sizeof(value));
+}
+
+// The sequence of an intact slot holding a record of at most 'record_size' bytes, or 0
+std::uint64_t IntactSequence(const std::uint8_t* slot, std::size_t record_size) {
+  auto length = Load<std::uint32_t>(slot + 4);
+  if (length > record_size) {
+    return 0;
+  }
+  std::size_t checked = CheckpointFile::kSlotHeaderSize - 4 + length;
+  return Crc32(slot + 4, checked) == Load<std::uint32_t>(slot) ? Load<std::uint64_t>(slot + 8) : 0;
+}
+
+} // namespace
+
+CheckpointFile::CheckpointFile(const std::string& filename, std::size_t record_size, std::uint32_t max_records)
+    : filename(filename), recordSize(record_size), fileRecordSize(record_size), maxRecords(max_records) {
+  fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  struct stat info{};
+  if (fd < 0 || ::fstat(fd, &info) != 0) {
+    throw FileException("Could not open " + filename);
+  }
+
+  // Reserve the address space for every record up front, so the mapping never moves while Sync
+  // runs elsewhere; only the file behind it grows
+  auto existing = static_cast<std::size_t>(info.st_size);
+  mappingSize = std::max(existing, FILE_HEADER_SIZE + 2 * std::size_t{max_records} * slotSize(record_size));
+  void* address = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    ::close(fd);
+    throw FileException("Could not map " + filename);
+  }
+  mapping = static_cast<std::uint8_t*>(address);
+  fileSize.store(existing);
+
+  if (existing >= FILE_HEADER_SIZE && std::memcmp(mapping, MAGIC, sizeof(MAGIC)) == 0) {
+    fileRecordSize = Load<std::uint32_t>(mapping + sizeof(MAGIC));
+    if (FILE_HEADER_SIZE + slotSize(fileRecordSize) > mappingSize) {
+      fileRecordSize = recordSize;  // Not a file we wrote; nothing in it survives
+      Reset();
+    }
+  } else {
+    Reset();
+  }
+}
+
+CheckpointFile::~CheckpointFile() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, mappingSize);
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+std::vector<std::pair<std::uint32_t, std::vector<std::uint8_t>>> CheckpointFile::ReadAll() const {
+  std::vector<std::pair<std::uint32_t, std::vector<std::uint8_t>>> records;
+  std::size_t size = fileSize.load();
+  std::size_t slots = size > FILE_HEADER_SIZE ? (size - FILE_HEADER_SIZE) / slotSize(fileRecordSize) : 0;
+  for (std::uint32_t index = 0; 2 * std::size_t{index} + 1 < slots; ++index) {
+    const std::uint8_t* a = slot(index, 0);
+    const std::uint8_t* b = slot(index, 1);
+    std::uint64_t sequenceA = IntactSequence(a, fileRecordSize);
+    std::uint64_t sequenceB = IntactSequence(b, fileRecordSize);
+    if (sequenceA == 0 && sequenceB == 0) {
+      continue;
+    }
+    const std::uint8_t* newest = sequenceA > sequenceB ? a : b;
+    auto length = Load<std::uint32_t>(newest + 4);
+    if (length > 0) {
+      const std::uint8_t* payload = newest + kSlotHeaderSize;
+      records.emplace_back(index, std::vector<std::uint8_t>(payload, payload + length));
+    }
+  }
+  return records;
+}
+
+void CheckpointFile::Reset() {
+  fileRecordSize = recordSize;
+  if (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, FILE_HEADER_SIZE) != 0) {
+    throw FileException("Could not resize " + filename);
+  }
+  fileSize.store(FILE_HEADER_SIZE);
+  writeHeader();
+}
+
+bool CheckpointFile::Write(std::uint32_t index, std::span<const std::uint8_t> record) {
+  if (record.size() > recordSize || index >= maxRecords) {
+    return false;
+  }
+  if (fileRecordSize != recordSize) {
+    Reset();
+  }
+  grow(index);
+  stamp(index, record, true);
+  return true;
+}
+
+void CheckpointFile::Clear(std::uint32_t index) {
+  std::size_t end = FILE_HEADER_SIZE + (2 * std::size_t{index} + 2) * slotSize(recordSize);
+  if (fileRecordSize == recordSize && index < maxRecords && end <= fileSize.load(std::memory_order_relaxed)) {
+    stamp(index, {}, false);
+  }
+}
+
+void CheckpointFile::Sync() const {
+  ::msync(mapping, fileSize.load(std::memory_order_acquire), MS_SYNC);
+}
+
+std::uint8_t* CheckpointFile::slot(std::uint32_t index, int which) const {
+  return mapping + FILE_HEADER_SIZE + (2 * std::size_t{index} + which) * slotSize(fileRecordSize);
+}
+
+void CheckpointFile::writeHeader() {
+  std::memset(mapping, 0, FILE_HEADER_SIZE);
+  std::memcpy(mapping, MAGIC, sizeof(MAGIC));
+  Store(mapping + sizeof(MAGIC), static_cast<std::uint32_t>(recordSize));
+}
+
+void CheckpointFile::grow(std::uint32_t index) {
+  std::size_t end = FILE_HEADER_SIZE + (2 * std::size_t{index} + 2) * slotSize(recordSize);
+  if (end <= fileSize.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::size_t records = std::min<std::size_t>((index / GROWTH_RECORDS + 1) * std::size_t{GROWTH_RECORDS}, maxRecords);
+  std::size_t size = FILE_HEADER_SIZE + 2 * records * slotSize(recordSize);
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    throw FileException("Could not resize " + filename);
+  }
+  fileSize.store(size, std::memory_order_release);
+}
+
+void CheckpointFile::stamp(std::uint32_t index, std::span<const std::uint8_t> record, bool live) {
+  // Overwrite the older copy, so the newer one stays intact until this one is complete
+  std::uint8_t* a = slot(index, 0);
+  std::uint8_t* b = slot(index, 1);
+  auto sequenceA = Load<std::uint64_t>(a + 8);
+  auto sequenceB = Load<std::uint64_t>(b + 8);
+  std::uint8_t* target = sequenceA <= sequenceB ? a : b;
+
+  if (!record.empty()) {
+    std::memcpy(target + kSlotHeaderSize, record.data(), record.size());
+  }
+  Store(target + 4, static_cast<std::uint32_t>(live ? record.size() : 0));
+  Store(target + 8, std::max(sequenceA, sequenceB) + 1);
+  Store(target, Crc32(target + 4, kSlotHeaderSize - 4 + record.size()));
+}
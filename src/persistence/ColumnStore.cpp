@@ -0,0 +1,313 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the columnar export of game outcomes.
+//
+
+#include "ColumnStore.hpp"
+#include "FileException.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <bit>
+#include <span>
+
+namespace {
+
+void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void PutFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int width) {
+  for (int i = 0; i < width; ++i) {
+    out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+std::uint64_t ZigZag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t UnZigZag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+std::vector<std::uint8_t> Encode(ColumnEncoding encoding, std::span<const std::uint64_t> values, int width) {
+  std::vector<std::uint8_t> out;
+  switch (encoding) {
+    case ColumnEncoding::Plain:
+      out.reserve(values.size() * width);
+      for (std::uint64_t value : values) {
+        PutFixed(out, value, width);
+      }
+      break;
+    case ColumnEncoding::RunLength:
+      for (std::size_t i = 0; i < values.size();) {
+        std::size_t run = 1;
+        while (i + run < values.size() && values[i + run] == values[i]) {
+          ++run;
+        }
+        PutVarint(out, values[i]);
+        PutVarint(out, run);
+        i += run;
+      }
+      break;
+    case ColumnEncoding::Delta: {
+      std::uint64_t previous = 0;
+      for (std::uint64_t value : values) {
+        PutVarint(out, ZigZag(static_cast<std::int64_t>(value - previous)));
+        previous = value;
+      }
+      break;
+    }
+    case ColumnEncoding::BitPacked: {
+      auto [low, high] = std::minmax_element(values.begin(), values.end());
+      std::uint64_t minimum = values.empty() ? 0 : *low;
+      int bits = values.empty() ? 0 : std::bit_width(*high - minimum);
+      PutVarint(out, minimum);
+      out.push_back(static_cast<std::uint8_t>(bits));
+      out.resize(out.size() + (values.size() * bits + 7) / 8, 0);
+      std::uint8_t* packed = out.data() + out.size() - (values.size() * bits + 7) / 8;
+      std::size_t bit = 0;
+      for (std::uint64_t value : values) {
+        std::uint64_t delta = value - minimum;
+        for (int b = 0; b < bits; ++b, ++bit) {
+          packed[bit / 8] |= static_cast<std::uint8_t>(((delta >> b) & 1) << (bit % 8));
+        }
+      }
+      break;
+    }
+  }
+  return out;
+}
+
+class ByteReader {
+public:
+  explicit ByteReader(std::span<const std::uint8_t> bytes) : pos(bytes.data()), end(bytes.data() + bytes.size()) {}
+
+  [[nodiscard]] bool AtEnd() const { return pos == end; }
+
+  std::uint64_t Fixed(int width) {
+    Need(width);
+    std::uint64_t value = 0;
+    for (int i = 0; i < width; ++i) {
+      value |= static_cast<std::uint64_t>(*pos++) << (8 * i);
+    }
+    return value;
+  }
+
+  std::uint64_t Varint() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      Need(1);
+      std::uint8_t byte = *pos++;
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw FileException("Oversized varint in column file");
+  }
+
+  std::span<const std::uint8_t> Bytes(std::size_t count) {
+    Need(count);
+    std::span<const std::uint8_t> bytes(pos, count);
+    pos += count;
+    return bytes;
+  }
+
+private:
+  const std::uint8_t* pos;
+  const std::uint8_t* end;
+
+  void Need(std::size_t count) const {
+    if (static_cast<std::size_t>(end - pos) < count) {
+      throw FileException("Truncated column file");
+    }
+  }
+};
+
+void Decode(ColumnEncoding encoding, std::span<const std::uint8_t> payload, std::uint32_t count, int width,
+            std::vector<std::uint64_t>& out) {
+  ByteReader in(payload);
+  switch (encoding) {
+    case ColumnEncoding::Plain:
+      for (std::uint32_t i = 0; i < count; ++i) {
+        out.push_back(in.Fixed(width));
+      }
+      break;
+    case ColumnEncoding::RunLength:
+      while (!in.AtEnd()) {
+        std::uint64_t value = in.Varint();
+        out.insert(out.end(), in.Varint(), value);
+      }
+      break;
+    case ColumnEncoding::Delta: {
+      std::uint64_t value = 0;
+      for (std::uint32_t i = 0; i < count; ++i) {
+        value += static_cast<std::uint64_t>(UnZigZag(in.Varint()));
+        out.push_back(value);
+      }
+      break;
+    }
+    case ColumnEncoding::BitPacked: {
+      std::uint64_t minimum = in.Varint();
+      int bits = static_cast<int>(in.Fixed(1));
+      auto packed = in.Bytes((static_cast<std::size_t>(count) * bits + 7) / 8);
+      std::size_t bit = 0;
+      for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint64_t delta = 0;
+        for (int b = 0; b < bits; ++b, ++bit) {
+          delta |= static_cast<std::uint64_t>((packed[bit / 8] >> (bit % 8)) & 1) << b;
+        }
+        out.push_back(minimum + delta);
+      }
+      break;
+    }
+    default:
+      throw FileException("Unknown column encoding");
+  }
+}
+
+} // namespace
+
+const std::vector<ColumnSpec>& GameOutcomeColumns() {
+  static const std::vector<ColumnSpec> columns = {
+      {"players", 2, [](const GameOutcome& o) -> std::uint64_t { return o.numPlayers; }},
+      {"bids", 4, [](const GameOutcome& o) -> std::uint64_t { return o.bids; }},
+      {"rejected_bids", 4, [](const GameOutcome& o) -> std::uint64_t { return o.rejectedBids; }},
+      {"bid_count", 4, [](const GameOutcome& o) -> std::uint64_t { return o.finalDiceCount; }},
+      {"bid_face", 1, [](const GameOutcome& o) -> std::uint64_t { return o.finalDiceValue; }},
+      {"actual_count", 4, [](const GameOutcome& o) -> std::uint64_t { return o.actualCount; }},
+      {"guesser", 4, [](const GameOutcome& o) -> std::uint64_t { return o.guessingPlayerId; }},
+      {"caller", 4, [](const GameOutcome& o) -> std::uint64_t { return o.callingPlayerId; }},
+      {"winner", 4, [](const GameOutcome& o) -> std::uint64_t { return o.WinnerId(); }},
+      {"guesser_won", 1, [](const GameOutcome& o) -> std::uint64_t { return o.guesserWon; }},
+  };
+  return columns;
+}
+
+ColumnarWriter::ColumnarWriter(const std::filesystem::path& directory) : directory(directory) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    throw FileException("Could not create " + directory.string());
+  }
+  for (const auto& column : GameOutcomeColumns()) {
+    files.emplace_back(directory / (std::string(column.name) + ".col"), std::ios::binary | std::ios::trunc);
+    if (!files.back()) {
+      throw FileException("Could not create column file for " + std::string(column.name));
+    }
+    pending.emplace_back();
+    pending.back().reserve(kChunkRows);
+  }
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  try {
+    Close();
+  } catch (const FileException&) {
+    // Nothing sensible left to do with a failing export while unwinding
+  }
+}
+
+void ColumnarWriter::Append(const GameOutcome& outcome) {
+  const auto& columns = GameOutcomeColumns();
+  for (std::size_t i = 0; i < columns.size(); ++i) {
+    pending[i].push_back(columns[i].extract(outcome));
+  }
+  if (++rows % kChunkRows == 0) {
+    flushChunk();
+  }
+}
+
+void ColumnarWriter::Close() {
+  if (closed) {
+    return;
+  }
+  closed = true;
+  flushChunk();
+
+  std::vector<std::uint8_t> schema(kColumnStoreMagic.begin(), kColumnStoreMagic.end());
+  PutFixed(schema, rows, 8);
+  PutFixed(schema, GameOutcomeColumns().size(), 4);
+  for (const auto& column : GameOutcomeColumns()) {
+    std::string name = column.name;
+    schema.push_back(static_cast<std::uint8_t>(name.size()));
+    schema.insert(schema.end(), name.begin(), name.end());
+    schema.push_back(column.width);
+  }
+
+  std::ofstream schema_file(directory / "schema", std::ios::binary | std::ios::trunc);
+  schema_file.write(reinterpret_cast<const char*>(schema.data()), static_cast<std::streamsize>(schema.size()));
+  if (!schema_file) {
+    throw FileException("Could not write column schema");
+  }
+}
+
+void ColumnarWriter::flushChunk() {
+  const auto& columns = GameOutcomeColumns();
+  if (pending.empty() || pending.front().empty()) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < columns.size(); ++i) {
+    // Keep whichever encoding gives the smallest chunk
+    auto encoding = ColumnEncoding::Plain;
+    auto best = Encode(encoding, pending[i], columns[i].width);
+    for (auto candidate : {ColumnEncoding::RunLength, ColumnEncoding::Delta, ColumnEncoding::BitPacked}) {
+      auto encoded = Encode(candidate, pending[i], columns[i].width);
+      if (encoded.size() < best.size()) {
+        best = std::move(encoded);
+        encoding = candidate;
+      }
+    }
+
+    std::vector<std::uint8_t> header;
+    header.push_back(static_cast<std::uint8_t>(encoding));
+    PutFixed(header, pending[i].size(), 4);
+    PutFixed(header, best.size(), 4);
+    files[i].write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    files[i].write(reinterpret_cast<const char*>(best.data()), static_cast<std::streamsize>(best.size()));
+    if (!files[i]) {
+      throw FileException("Could not write column " + std::string(columns[i].name));
+    }
+    pending[i].clear();
+  }
+}
+
+ColumnarReader::ColumnarReader(const std::filesystem::path& directory) : directory(directory) {
+  MappedFile schema((directory / "schema").string());
+  ByteReader in(schema.Bytes());
+  auto magic = in.Bytes(kColumnStoreMagic.size());
+  if (!std::equal(kColumnStoreMagic.begin(), kColumnStoreMagic.end(), magic.begin())) {
+    throw FileException(directory.string() + " is not a Liar's Dice column export");
+  }
+  rows = in.Fixed(8);
+  auto count = in.Fixed(4);
+  for (std::uint64_t i = 0; i < count; ++i) {
+    auto name = in.Bytes(in.Fixed(1));
+    columns.push_back({std::string(name.begin(), name.end()), static_cast<std::uint8_t>(in.Fixed(1))});
+  }
+}
+
+std::vector<std::uint64_t> ColumnarReader::ReadColumn(const std::string& name) const {
+  auto column = std::find_if(columns.begin(), columns.end(), [&](const Column& c) { return c.name == name; });
+  if (column == columns.end()) {
+    throw FileException("No column named " + name);
+  }
+
+  std::vector<std::uint64_t> values;
+  values.reserve(rows);
+  MappedFile file((directory / (name + ".col")).string());
+  ByteReader in(file.Bytes());
+  while (!in.AtEnd()) {
+    auto encoding = static_cast<ColumnEncoding>(in.Fixed(1));
+    auto count = static_cast<std::uint32_t>(in.Fixed(4));
+    auto payload = in.Bytes(in.Fixed(4));
+    Decode(encoding, payload, count, column->width, values);
+  }
+  return values;
+}
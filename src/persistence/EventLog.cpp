@@ -0,0 +1,86 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the EventLog and EventLogWriter classes.
+//
+
+#include "EventLog.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+
+namespace {
+
+void PutU32(std::uint8_t* out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+} // namespace
+
+EventLog::EventLog(const std::string& filename)
+    : file(filename, std::ios::binary | std::ios::out | std::ios::trunc) {
+  if (!file) {
+    throw FileException("Could not open event log " + filename);
+  }
+  file.write(kEventLogMagic.data(), kEventLogMagic.size());
+}
+
+void EventLog::AppendBlock(const std::uint8_t* data, std::size_t size) {
+  std::lock_guard<std::mutex> lock(fileMutex);
+  file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+  if (!file) {
+    throw FileException("Could not write to event log");
+  }
+}
+
+void EventLog::Flush() {
+  std::lock_guard<std::mutex> lock(fileMutex);
+  file.flush();
+}
+
+EventLogWriter::EventLogWriter(EventLog& log, std::size_t block_size)
+    : log(log), buffer(block_size + block_size / 4 + kEventLogBlockHeaderSize), blockSize(block_size) {
+}
+
+EventLogWriter::~EventLogWriter() {
+  try {
+    Flush();
+  } catch (const FileException&) {
+    // Nothing sensible left to do with a failing log while unwinding
+  }
+}
+
+void EventLogWriter::Flush() {
+  if (gamesInBlock == 0) {
+    return;
+  }
+  PutU32(buffer.data(), static_cast<std::uint32_t>(used - kEventLogBlockHeaderSize));
+  PutU32(buffer.data() + 4, gamesInBlock);
+  log.AppendBlock(buffer.data(), used);
+  used = kEventLogBlockHeaderSize;
+  gamesInBlock = 0;
+}
+
+void EventLogWriter::FlushFinishedGames() {
+  if (!gameOpen) {
+    Flush();
+    return;
+  }
+  if (gamesInBlock <= 1) {
+    return;
+  }
+  PutU32(buffer.data(), static_cast<std::uint32_t>(gameStart - kEventLogBlockHeaderSize));
+  PutU32(buffer.data() + 4, gamesInBlock - 1);
+  log.AppendBlock(buffer.data(), gameStart);
+  // The open game moves to the front of the next block
+  std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(gameStart), buffer.begin() + static_cast<std::ptrdiff_t>(used),
+            buffer.begin() + kEventLogBlockHeaderSize);
+  used = kEventLogBlockHeaderSize + (used - gameStart);
+  gameStart = kEventLogBlockHeaderSize;
+  gamesInBlock = 1;
+}
+
+void EventLogWriter::Grow(std::size_t required) {
+  // Only a single very long game can outgrow the preallocated block plus slack
+  buffer.resize(std::max(required, buffer.size() * 2));
+}
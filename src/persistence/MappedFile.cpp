@@ -0,0 +1,67 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the MappedFile class.
+//
+
+#include "MappedFile.hpp"
+#include "FileException.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename) {
+  std::ifstream file_handle(filename, std::ios::binary);
+  if (!file_handle) {
+    throw FileException("Could not open " + filename);
+  }
+  fallback.assign(std::istreambuf_iterator<char>(file_handle), std::istreambuf_iterator<char>());
+  data = fallback.data();
+  size = fallback.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw FileException("Could not open " + filename);
+  }
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw FileException("Could not stat " + filename);
+  }
+
+  size = static_cast<std::size_t>(info.st_size);
+  if (size > 0) {
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw FileException("Could not map " + filename);
+    }
+    // Logs are scanned front to back exactly once
+    ::madvise(mapping, size, MADV_SEQUENTIAL | MADV_WILLNEED);
+    data = static_cast<const std::uint8_t*>(mapping);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data != nullptr) {
+    ::munmap(const_cast<std::uint8_t*>(data), size);
+  }
+}
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the ReplayReader and EventCursor classes.
+//
+
+#include "ReplayReader.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+
+namespace {
+
+std::uint32_t GetU32(const std::uint8_t* in) {
+  return static_cast<std::uint32_t>(in[0]) | static_cast<std::uint32_t>(in[1]) << 8 |
+         static_cast<std::uint32_t>(in[2]) << 16 | static_cast<std::uint32_t>(in[3]) << 24;
+}
+
+int UnZigZag(std::uint32_t value) {
+  return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+}
+
+} // namespace
+
+ReplayReader::ReplayReader(const std::string& filename) : file(filename) {
+  std::span<const std::uint8_t> bytes = file.Bytes();
+  if (bytes.size() < kEventLogMagic.size() ||
+      !std::equal(kEventLogMagic.begin(), kEventLogMagic.end(), bytes.begin())) {
+    throw FileException(filename + " is not a Liar's Dice event log");
+  }
+
+  std::size_t offset = kEventLogMagic.size();
+  while (offset + kEventLogBlockHeaderSize <= bytes.size()) {
+    std::uint32_t payload_size = GetU32(bytes.data() + offset);
+    std::uint32_t game_count = GetU32(bytes.data() + offset + 4);
+    std::size_t payload_offset = offset + kEventLogBlockHeaderSize;
+    if (payload_size > bytes.size() - payload_offset) {
+      // A block cut short by a crash; everything before it is still usable
+      break;
+    }
+    blocks.push_back({bytes.subspan(payload_offset, payload_size), game_count, offset});
+    offset = payload_offset + payload_size;
+  }
+  truncatedBytes = bytes.size() - offset;
+}
+
+std::uint32_t EventCursor::ReadVarint() {
+  std::uint32_t value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (pos == end) {
+      throw FileException("Truncated varint in event log");
+    }
+    std::uint8_t byte = *pos++;
+    value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw FileException("Oversized varint in event log");
+}
+
+int EventCursor::ReadPlayer() {
+  lastPlayerId += UnZigZag(ReadVarint());
+  return lastPlayerId;
+}
+
+bool EventCursor::Next(ReplayEvent& event) {
+  if (pos == end) {
+    return false;
+  }
+
+  event = ReplayEvent{};
+  event.type = static_cast<EventType>(*pos++);
+  switch (event.type) {
+    case EventType::GameStart:
+      lastPlayerId = 0;
+      lastDiceCount = 0;
+      event.numPlayers = static_cast<int>(ReadVarint());
+      break;
+    case EventType::Roll: {
+      event.playerId = ReadPlayer();
+      std::uint32_t count = ReadVarint();
+      if (count > static_cast<std::size_t>(end - pos)) {
+        throw FileException("Truncated roll in event log");
+      }
+      event.faces = {pos, count};
+      if (std::any_of(event.faces.begin(), event.faces.end(), [](std::uint8_t face) { return face & 0x80; })) {
+        throw FileException("Face value out of range in event log");
+      }
+      pos += count;
+      break;
+    }
+    case EventType::Bid:
+    case EventType::RejectedBid:
+      event.playerId = ReadPlayer();
+      lastDiceCount += UnZigZag(ReadVarint());
+      event.diceCount = lastDiceCount;
+      event.diceValue = static_cast<int>(ReadVarint());
+      break;
+    case EventType::LiarCall:
+    case EventType::SpotOnCall:
+      event.playerId = ReadPlayer();
+      break;
+    case EventType::Rules:
+      event.ruleVariant = ReadVarint();
+      break;
+    case EventType::Faces:
+      event.dieFaces = ReadVarint();
+      break;
+    case EventType::Resolution:
+      if (pos == end) {
+        throw FileException("Truncated resolution in event log");
+      }
+      event.guesserWon = (*pos++ == 0);
+      break;
+    default:
+      throw FileException("Unknown event type in event log");
+  }
+  return true;
+}
@@ -0,0 +1,185 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the GameServer class.
+//
+
+#include "GameServer.hpp"
+#include "CustomException.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <sys/resource.h>
+
+namespace {
+
+GameServer* activeServer = nullptr;
+
+constexpr std::chrono::milliseconds CHECKPOINT_SYNC_INTERVAL(200);
+
+void HandleStopSignal(int) {
+  if (activeServer != nullptr) {
+    activeServer->Stop();
+  }
+}
+
+// Every connection is a file descriptor; the default soft limit of 1024 is far below what the loops can serve
+void RaiseFileLimit() {
+  rlimit limit{};
+  if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+  }
+}
+
+} // namespace
+
+GameServer::GameServer(const ServerOptions& options)
+    : matchmaker(options.tableSize, options.queueCapacity,
+                 [this](std::vector<ConnectionPtr>& group) { seatGroup(group); }) {
+  RaiseFileLimit();
+  unsigned count = options.loops != 0 ? options.loops : std::max(1u, std::thread::hardware_concurrency());
+
+  if (!options.checkpointDir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(options.checkpointDir, error);
+  }
+
+  // The first loop resolves port 0 to a real port; the others join it through SO_REUSEPORT
+  loops.push_back(std::make_unique<ServerLoop>(options, 0, options.port, options.spectatorPort, matchmaker));
+  for (unsigned i = 1; i < count; ++i) {
+    loops.push_back(std::make_unique<ServerLoop>(options, i, loops.front()->Port(), loops.front()->SpectatorPort(),
+                                                 matchmaker));
+  }
+  std::vector<ServerLoop*> peers;
+  for (const auto& loop : loops) {
+    peers.push_back(loop.get());
+  }
+  for (const auto& loop : loops) {
+    loop->SetPeers(peers);
+  }
+
+  if (!options.checkpointDir.empty()) {
+    restoreCheckpoints(options.checkpointDir);
+  }
+  checkpointing = !options.checkpointDir.empty();
+}
+
+GameServer::~GameServer() {
+  Stop();
+  Wait();
+}
+
+void GameServer::Start() {
+  matchmaker.Start();
+  for (auto& loop : loops) {
+    threads.emplace_back([this, &loop] { loop->Run(stopping); });
+  }
+  if (checkpointing) {
+    // The loops only copy records into their mappings; getting them to disk happens here
+    checkpointThread = std::thread([this] {
+      while (!stopping.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(CHECKPOINT_SYNC_INTERVAL);
+        for (const auto& loop : loops) {
+          loop->SyncCheckpoint();
+        }
+      }
+    });
+  }
+}
+
+void GameServer::Stop() {
+  stopping.store(true, std::memory_order_relaxed);
+  for (const auto& loop : loops) {
+    loop->Wake();
+  }
+}
+
+void GameServer::Wait() {
+  for (auto& thread : threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads.clear();
+  if (checkpointThread.joinable()) {
+    checkpointThread.join();
+    for (const auto& loop : loops) {
+      loop->SyncCheckpoint();
+    }
+  }
+  matchmaker.Stop();
+}
+
+void GameServer::restoreCheckpoints(const std::string& directory) {
+  // Files of loops beyond the current count (the server ran with more before) are shared out
+  std::vector<std::vector<std::string>> orphans(loops.size());
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    std::string name = entry.path().filename().string();
+    if (!name.starts_with("loop-") || !name.ends_with(".ckpt")) {
+      continue;
+    }
+    unsigned index = 0;
+    const char* digits = name.data() + 5;
+    const char* end = name.data() + name.size() - 5;
+    if (auto [last, parsed] = std::from_chars(digits, end, index); parsed == std::errc() && last == end &&
+        index >= loops.size()) {
+      orphans[index % loops.size()].push_back(entry.path().string());
+    }
+  }
+  for (std::size_t i = 0; i < loops.size(); ++i) {
+    restoredTables += loops[i]->RestoreCheckpoints(orphans[i]);
+  }
+}
+
+void GameServer::seatGroup(std::vector<ConnectionPtr>& group) {
+  // Round-robin over the loops, skipping any whose inbox is full
+  while (!stopping.load(std::memory_order_relaxed)) {
+    for (std::size_t attempt = 0; attempt < loops.size(); ++attempt) {
+      if (loops[nextLoop++ % loops.size()]->Seat(std::move(group))) {
+        return;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+int RunServer(const ServerOptions& options) {
+  try {
+    GameServer server(options);
+    activeServer = &server;
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    std::cout << "Serving Liar's Dice on " << options.host << ':' << server.Port() << " with "
+              << server.LoopCount() << " event loops, " << options.tableSize << " players per table\n";
+    if (options.turnTime.count() > 0) {
+      std::cout << "Turns time out after " << options.turnTime.count() / 1000.0 << " s\n";
+    }
+    if (auto spectators = server.SpectatorPort()) {
+      std::cout << "Spectators connect on port " << *spectators << '\n';
+    }
+    if (!options.checkpointDir.empty()) {
+      std::cout << "Checkpointing tables to " << options.checkpointDir << ", restored " << server.RestoredTables()
+                << " tables\n";
+    }
+    std::cout << std::flush;
+    server.Start();
+    server.Wait();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    activeServer = nullptr;
+
+    MatchmakingStats stats = server.Stats();
+    std::cout << "Matchmaking: " << stats.enqueued << " players queued, " << stats.rejected << " turned away, "
+              << stats.tablesSeated << " tables seated, queue depth peaked at " << stats.maxDepth << '\n';
+    return EXIT_SUCCESS;
+  } catch (const CustomException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,968 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the ServerLoop class and its tables.
+//
+
+#include "ServerLoop.hpp"
+#include "GameLogicException.hpp"
+#include "NetworkException.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int MAX_EVENTS = 512;
+constexpr int LISTEN_BACKLOG = 4096;
+constexpr std::size_t READ_CHUNK_SIZE = 16 * 1024;
+constexpr std::size_t INBOX_CAPACITY = 1024;  // Seated groups not yet picked up by the loop
+constexpr int MAX_IOVECS = 64;                   // Shared buffers gathered into one sendmsg
+constexpr std::size_t MAX_SHARED_BACKLOG = 4096; // Unsent shared buffers before a spectator is dropped
+constexpr std::uint32_t MAX_CHECKPOINT_TABLES = 1 << 20;  // Per loop; later tables are not checkpointed
+constexpr std::chrono::seconds RECLAIM_GRACE(30);       // How long a restored seat waits for its player
+
+std::string SystemError(const std::string& what) {
+  return what + ": " + std::strerror(errno);
+}
+
+const std::string IMPOSSIBLE_BID_MSG = "Invalid guess. The number of dice must be from 1 to the dice in play and "
+                                       "the face value from 1 to the faces of a die.\n";
+
+std::uint32_t RankOf(const Guess& guess) {
+  return BidRank(guess.diceCount, guess.diceValue);
+}
+
+// Whether a table of 'dice' dice with 'faces' faces each could hold the bid at all; a rank off the
+// wire or out of a checkpoint may name anything, and the rule variant only checks the raise
+bool IsPossibleBid(const Guess& bid, unsigned faces, int dice) {
+  return bid.diceCount >= 1 && bid.diceCount <= dice && bid.diceValue >= 1 &&
+         static_cast<unsigned>(bid.diceValue) <= faces;
+}
+
+void SendError(std::vector<std::uint8_t>& out, WireError error) {
+  FrameBuilder(out, MessageType::Error).U8(static_cast<std::uint8_t>(error));
+}
+
+// Checkpoint records are little-endian like the wire protocol:
+//   u8 players, u8 current player index, u8 awaiting call, u8 rule variant, u32 last bid rank,
+//   then per seat u64 seat key and the dice as on the wire (u8 count, packed faces)
+std::size_t CheckpointRecordSize(int players, int dice_per_player) {
+  return 8 + static_cast<std::size_t>(players) * (8 + 1 + (dice_per_player + 1) / 2);
+}
+
+// Seat keys carry the index of the loop that issued them in their top byte
+std::size_t OwnerOf(std::uint64_t key, std::size_t loops) {
+  return static_cast<std::size_t>(key >> 56) % std::max<std::size_t>(loops, 1);
+}
+
+void AppendInteger(std::vector<std::uint8_t>& out, std::uint64_t value, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+// A non-blocking listening socket on host:port; 'bound_port' receives the port actually bound
+int OpenListener(const std::string& host, std::uint16_t port, std::uint16_t& bound_port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw NetworkException(SystemError("Could not create server sockets"));
+  }
+  int enable = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    ::close(fd);
+    throw NetworkException("Invalid listen address " + host);
+  }
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::listen(fd, LISTEN_BACKLOG) != 0) {
+    std::string error = SystemError("Could not listen on " + host + ':' + std::to_string(port));
+    ::close(fd);
+    throw NetworkException(error);
+  }
+  socklen_t length = sizeof(address);
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+  bound_port = ntohs(address.sin_port);
+  return fd;
+}
+
+} // namespace
+
+// A table is also the decision source for its seats: requests wait for the seat's next frame
+class ServerLoop::Table : public PlayerDecisions {
+public:
+  struct Seat {
+    Connection* connection = nullptr;
+    GuessRequest* pendingGuess = nullptr;
+    LiarCallRequest* pendingCall = nullptr;
+    std::uint32_t lastBidRank = 0;  // Echoed back if the game rejects the bid
+    TimerId deadline{};             // Runs from the Turn or CallPrompt until the decision is accepted
+    std::uint64_t key = 0;          // Identifies the seat to Resume
+    bool reserved = false;          // Restored from a checkpoint; decisions wait for the player to return
+  };
+
+  ServerLoop* loop = nullptr;
+  TableHandle handle;
+  Game game;
+  std::vector<Seat> seats;
+  std::vector<Connection*> watchers;
+  std::uint32_t currentBidRank = 0;
+  SharedFrames snapshot;  // Encoded on demand, dropped by the next event
+
+  // Encodes the table's state once for any number of new watchers
+  const SharedFrames& Snapshot() {
+    if (!snapshot) {
+      std::vector<std::uint8_t> bytes;
+      {
+        FrameBuilder frame(bytes, MessageType::Snapshot);
+        frame.U8(static_cast<std::uint8_t>(seats.size())).U32(currentBidRank);
+        for (const auto& player : game.GetPlayers()) {
+          frame.U8(static_cast<std::uint8_t>(player.GetDice().size()));
+        }
+      }
+      snapshot = std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes));
+    }
+    return snapshot;
+  }
+
+  // Queues the same encoded event on every watcher; watchers too far behind are dropped
+  void Publish(const SharedFrames& frames) {
+    for (std::size_t i = watchers.size(); i-- > 0;) {
+      if (watchers[i]->shared.size() >= MAX_SHARED_BACKLOG) {
+        loop->closeConnection(*watchers[i]);  // Swaps the last watcher, already served, into i
+        continue;
+      }
+      loop->share(*watchers[i], frames);
+    }
+  }
+
+  void RequestGuess(GuessRequest& request) override {
+    loop->checkpointTable(*this, false);
+    Seat& seat = seats[request.player.GetPlayerId() - 1];
+    if (seat.connection == nullptr && !seat.reserved) {
+      request.Complete(MinimumRaise(request.lastGuess));
+      return;
+    }
+    seat.pendingGuess = &request;
+    if (seat.connection != nullptr) {
+      FrameBuilder(loop->outbox(*seat.connection), MessageType::Turn).U32(RankOf(request.lastGuess));
+    }
+    // A rejected bid asks again on the same clock
+    if (!seat.deadline.IsValid()) {
+      startClock(request.player.GetPlayerId() - 1);
+    }
+  }
+
+  void RequestLiarCall(LiarCallRequest& request) override {
+    stopClock(seats[request.player.GetPlayerId() - 1]);  // The bid was accepted
+    currentBidRank = RankOf(request.lastGuess);
+    snapshot.reset();
+    loop->checkpointTable(*this, true);
+    if (!watchers.empty()) {
+      std::vector<std::uint8_t> bytes;
+      FrameBuilder(bytes, MessageType::BidMade)
+          .U8(static_cast<std::uint8_t>(request.player.GetPlayerId()))
+          .U32(currentBidRank);
+      Publish(std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes)));
+    }
+    for (auto& other : seats) {
+      if (other.connection != nullptr) {
+        FrameBuilder(loop->outbox(*other.connection), MessageType::BidMade)
+            .U8(static_cast<std::uint8_t>(request.player.GetPlayerId()))
+            .U32(RankOf(request.lastGuess));
+      }
+    }
+    // The next seat answers, and is recorded as the caller whoever answers for it
+    int caller = request.caller->GetPlayerId() - 1;
+    Seat& seat = seats[caller];
+    if (seat.connection == nullptr && !seat.reserved) {
+      request.Complete(CallType::Liar);
+      return;
+    }
+    seat.pendingCall = &request;
+    if (seat.connection != nullptr) {
+      FrameBuilder(loop->outbox(*seat.connection), MessageType::CallPrompt);
+    }
+    startClock(caller);
+  }
+
+  void OnInvalidGuess(const Player& player, const std::string& error) override {
+    Seat& seat = seats[player.GetPlayerId() - 1];
+    if (seat.connection != nullptr) {
+      FrameBuilder(loop->outbox(*seat.connection), MessageType::Invalid).U32(seat.lastBidRank).Text(error);
+    }
+  }
+
+  // Routes a decision from the seat's connection to whatever is pending
+  void Deliver(int seat_index, const Frame& frame) {
+    Seat& seat = seats[seat_index];
+    PayloadReader payload(frame.payload);
+    if (frame.type == MessageType::PlaceBid && seat.pendingGuess != nullptr) {
+      std::uint32_t rank = payload.U32();
+      if (payload.Done()) {
+        seat.lastBidRank = rank;
+        if (!IsPossibleBid(Guess(BidFromRank(rank)), game.GetConfig().faces, seat.pendingGuess->totalDice)) {
+          // Asked again on the same clock, like a bid the game rejects
+          FrameBuilder(loop->outbox(*seat.connection), MessageType::Invalid).U32(rank).Text(IMPOSSIBLE_BID_MSG);
+          return;
+        }
+        std::exchange(seat.pendingGuess, nullptr)->Complete(BidFromRank(rank));
+        return;
+      }
+    } else if (frame.type == MessageType::Call && seat.pendingCall != nullptr) {
+      auto call = static_cast<CallType>(payload.U8());
+      bool allowed = call == CallType::Pass || SelectRules(game.GetRules()).isAllowedCall(call);
+      if (payload.Done() && allowed) {
+        stopClock(seat);
+        std::exchange(seat.pendingCall, nullptr)->Complete(call);
+        return;
+      }
+    } else if (frame.type == MessageType::PlaceBid || frame.type == MessageType::Call) {
+      SendError(loop->outbox(*seat.connection), WireError::NotYourTurn);
+      return;
+    }
+    SendError(loop->outbox(*seat.connection), WireError::Malformed);
+  }
+
+  // The seat's connection closed; answer anything pending on its behalf so the game can finish
+  void Abandon(int seat_index) {
+    Seat& seat = seats[seat_index];
+    seat.connection = nullptr;
+    stopClock(seat);
+    moveFor(seat);
+  }
+
+  // The seat's turn time ran out
+  void TimeOut(int seat_index) {
+    Seat& seat = seats[seat_index];
+    seat.deadline = {};
+    if (seat.connection != nullptr && (seat.pendingGuess != nullptr || seat.pendingCall != nullptr)) {
+      FrameBuilder(loop->outbox(*seat.connection), MessageType::TimedOut);
+    }
+    if (seat.reserved) {
+      // Nobody came back for the seat; play it like a disconnected one from now on
+      seat.reserved = false;
+      loop->reservedSeats.erase(seat.key);
+    }
+    moveFor(seat);
+  }
+
+  // A player returned to a restored seat: catch the connection up and ask again for what is pending
+  void Reclaim(int seat_index, Connection& connection) {
+    Seat& seat = seats[seat_index];
+    seat.connection = &connection;
+    seat.reserved = false;
+    auto& out = loop->outbox(connection);
+    FrameBuilder(out, MessageType::Seated)
+        .U8(static_cast<std::uint8_t>(seat_index + 1))
+        .U8(static_cast<std::uint8_t>(seats.size()))
+        .U64(seat.key);
+    FrameBuilder(out, MessageType::Dice).Faces(game.GetPlayers()[seat_index].GetDice());
+    if (seat.pendingGuess != nullptr) {
+      FrameBuilder(out, MessageType::Turn).U32(RankOf(seat.pendingGuess->lastGuess));
+    } else if (seat.pendingCall != nullptr) {
+      FrameBuilder(out, MessageType::BidMade)
+          .U8(static_cast<std::uint8_t>(seat.pendingCall->player.GetPlayerId()))
+          .U32(RankOf(seat.pendingCall->lastGuess));
+      FrameBuilder(out, MessageType::CallPrompt);
+    } else {
+      return;
+    }
+    stopClock(seat);
+    startClock(seat_index);
+  }
+
+  // Forgets the seats nobody reclaimed
+  void ReleaseReservations() {
+    for (auto& seat : seats) {
+      if (std::exchange(seat.reserved, false)) {
+        loop->reservedSeats.erase(seat.key);
+      }
+    }
+  }
+
+  void StopClocks() {
+    for (auto& seat : seats) {
+      stopClock(seat);
+    }
+  }
+
+private:
+  // Answers whatever the seat owes with the move that is always valid
+  static void moveFor(Seat& seat) {
+    if (seat.pendingGuess != nullptr) {
+      auto* request = std::exchange(seat.pendingGuess, nullptr);
+      request->Complete(MinimumRaise(request->lastGuess));
+    }
+    if (seat.pendingCall != nullptr) {
+      std::exchange(seat.pendingCall, nullptr)->Complete(CallType::Liar);
+    }
+  }
+
+  void startClock(int seat_index) {
+    std::chrono::milliseconds limit = seats[seat_index].connection != nullptr ? loop->options.turnTime : RECLAIM_GRACE;
+    if (limit.count() > 0) {
+      seats[seat_index].deadline = loop->turnTimers.Arm(limit, {handle, seat_index});
+    }
+  }
+
+  void stopClock(Seat& seat) { loop->turnTimers.Cancel(std::exchange(seat.deadline, {})); }
+};
+
+ServerConnection::~ServerConnection() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+ServerLoop::ServerLoop(const ServerOptions& options, unsigned index, std::uint16_t port,
+                       std::optional<std::uint16_t> spectator_port, ServerMatchmaker& matchmaker)
+    : options(options), index(index), matchmaker(matchmaker), inbox(INBOX_CAPACITY), arrivals(INBOX_CAPACITY) {
+  epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+  wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epollFd < 0 || wakeFd < 0) {
+    throw NetworkException(SystemError("Could not create server sockets"));
+  }
+  listenFd = OpenListener(options.host, port, this->port);
+  if (spectator_port) {
+    spectatorFd = OpenListener(options.host, *spectator_port, spectatorPort.emplace());
+  }
+
+  for (int fd : {listenFd, wakeFd, spectatorFd}) {
+    if (fd < 0) {
+      continue;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  if (!options.checkpointDir.empty()) {
+    checkpointPath =
+        (std::filesystem::path(options.checkpointDir) / ("loop-" + std::to_string(index) + ".ckpt")).string();
+    checkpoint = std::make_unique<CheckpointFile>(
+        checkpointPath, CheckpointRecordSize(options.tableSize, options.config->dicePerPlayer), MAX_CHECKPOINT_TABLES);
+  }
+}
+
+ServerLoop::~ServerLoop() {
+  connections.clear();
+  for (int fd : {listenFd, spectatorFd, wakeFd, epollFd}) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+void ServerLoop::Run(const std::atomic<bool>& stopping) {
+  epoll_event events[MAX_EVENTS];
+
+  while (!stopping.load(std::memory_order_relaxed)) {
+    int timeout = -1;
+    auto deadline = scheduler.NextDeadline();
+    if (auto turnDeadline = turnTimers.NextDeadline(); turnDeadline && (!deadline || *turnDeadline < *deadline)) {
+      deadline = turnDeadline;
+    }
+    if (deadline) {
+      auto wait = std::chrono::ceil<std::chrono::milliseconds>(*deadline - TableScheduler::Clock::now());
+      timeout = static_cast<int>(std::max<std::int64_t>(wait.count(), 0));
+    }
+
+    int ready = ::epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+    if (ready < 0 && errno != EINTR) {
+      throw NetworkException(SystemError("epoll_wait failed"));
+    }
+
+    for (int i = 0; i < ready; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == listenFd || fd == spectatorFd) {
+        acceptConnections(fd);
+        continue;
+      }
+      if (fd == wakeFd) {
+        std::uint64_t count;
+        while (::read(wakeFd, &count, sizeof(count)) > 0) {
+        }
+        continue;
+      }
+
+      if (static_cast<std::size_t>(fd) >= connections.size() || !connections[fd]) {
+        continue;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        closeConnection(*connections[fd]);
+        continue;
+      }
+      if (events[i].events & EPOLLIN) {
+        readFrom(*connections[fd]);
+      }
+      if ((events[i].events & EPOLLOUT) && connections[fd]) {
+        writeTo(*connections[fd]);
+      }
+    }
+
+    // Move for the seats out of time, resume the games whose decisions just arrived, open the tables
+    // seated here, then answer everyone at once
+    turnTimers.Advance(TableScheduler::Clock::now(), [this](const TurnTimer& timer) {
+      if (Table* table = tables.Get(timer.table)) {
+        table->TimeOut(timer.seat);
+      }
+    });
+    scheduler.RunReady();
+    openTables();
+    scheduler.RunReady();
+    flushDirty();
+  }
+}
+
+void ServerLoop::Wake() const {
+  std::uint64_t one = 1;
+  [[maybe_unused]] auto written = ::write(wakeFd, &one, sizeof(one));
+}
+
+bool ServerLoop::Transfer(ConnectionPtr&& connection) {
+  if (!arrivals.TryPush(std::move(connection))) {
+    return false;
+  }
+  Wake();
+  return true;
+}
+
+std::size_t ServerLoop::RestoreCheckpoints(const std::vector<std::string>& orphans) {
+  if (!checkpoint) {
+    return 0;
+  }
+  // Read everything before the own file is reset: restored tables get new slots in it
+  std::vector<std::pair<std::uint32_t, std::vector<std::uint8_t>>> records = checkpoint->ReadAll();
+  for (const auto& orphan : orphans) {
+    CheckpointFile file(orphan, 0, 0);
+    auto more = file.ReadAll();
+    records.insert(records.end(), std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+  }
+  // Tables from a run with more players or dice per player need bigger records than this run's
+  std::size_t recordSize = checkpoint->RecordSize();
+  for (const auto& record : records) {
+    recordSize = std::max(recordSize, record.second.size());
+  }
+  if (recordSize > checkpoint->RecordSize()) {
+    checkpoint.reset();
+    checkpoint = std::make_unique<CheckpointFile>(checkpointPath, recordSize, MAX_CHECKPOINT_TABLES);
+  }
+  checkpoint->Reset();
+
+  std::size_t restored = 0;
+  for (const auto& record : records) {
+    restored += restoreTable(record.second) ? 1 : 0;
+  }
+  // Play the restored games up to their pending decision: that rewrites their records into the reset
+  // file and starts the clocks that give up on absent players
+  scheduler.RunReady();
+  for (const auto& orphan : orphans) {
+    std::filesystem::remove(orphan);
+  }
+  return restored;
+}
+
+void ServerLoop::SyncCheckpoint() const {
+  if (checkpoint) {
+    checkpoint->Sync();
+  }
+}
+
+bool ServerLoop::Seat(std::vector<ConnectionPtr>&& group) {
+  if (!inbox.TryPush(std::move(group))) {
+    return false;
+  }
+  Wake();
+  return true;
+}
+
+void ServerLoop::acceptConnections(int listen_fd) {
+  while (true) {
+    int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      // EAGAIN: backlog drained. EMFILE and friends: retry when the listener fires again.
+      return;
+    }
+
+    int enable = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    auto connection = std::make_unique<Connection>();
+    connection->fd = fd;
+    if (listen_fd == spectatorFd) {
+      connection->spectator = true;
+      adopt(std::move(connection));
+    } else {
+      enqueueWaiting(std::move(connection));
+    }
+  }
+}
+
+void ServerLoop::adopt(ConnectionPtr connection) {
+  int fd = connection->fd;
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLRDHUP;
+  event.data.fd = fd;
+  ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+
+  if (static_cast<std::size_t>(fd) >= connections.size()) {
+    connections.resize(fd + 1);
+  }
+  connections[fd] = std::move(connection);
+  if (!connections[fd]->output.empty() || !connections[fd]->shared.empty()) {
+    markDirty(*connections[fd]);  // Whatever the previous loop could not send
+  }
+}
+
+void ServerLoop::readFrom(Connection& connection) {
+  // Receive straight behind the bytes already buffered, so frames are decoded where they land
+  while (true) {
+    std::size_t buffered = connection.input.size();
+    connection.input.resize(buffered + READ_CHUNK_SIZE);
+    ssize_t received = ::recv(connection.fd, connection.input.data() + buffered, READ_CHUNK_SIZE, 0);
+    connection.input.resize(buffered + static_cast<std::size_t>(std::max<ssize_t>(received, 0)));
+    if (received > 0) {
+      continue;
+    }
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    closeConnection(connection);  // Orderly shutdown or hard error
+    return;
+  }
+
+  // Decode every complete frame in place, then drop the consumed bytes in one go
+  std::span<const std::uint8_t> unread(connection.input);
+  Frame frame{};
+  FrameStatus status;
+  while (connection.resumeKey == 0 && (status = ReadFrame(unread, frame)) == FrameStatus::Complete) {
+    handleFrame(connection, frame);
+  }
+  if (status == FrameStatus::Malformed) {
+    closeConnection(connection);
+    return;
+  }
+  auto consumed = static_cast<std::ptrdiff_t>(connection.input.size() - unread.size());
+  connection.input.erase(connection.input.begin(), connection.input.begin() + consumed);
+
+  // Resuming a seat on another loop: the connection moves there with whatever else it sent
+  if (connection.resumeKey != 0) {
+    ServerLoop* owner = peers[OwnerOf(connection.resumeKey, peers.size())];
+    ConnectionPtr moving = detach(connection);
+    if (!owner->Transfer(std::move(moving))) {
+      connection.resumeKey = 0;
+      adopt(std::move(moving));
+      SendError(outbox(connection), WireError::ServerBusy);
+    }
+  }
+}
+
+void ServerLoop::writeTo(Connection& connection) {
+  if (!sendPending(connection)) {
+    closeConnection(connection);
+    return;
+  }
+
+  // Only ask for EPOLLOUT while the kernel buffer is full
+  bool wantWrite = !connection.output.empty() || !connection.shared.empty();
+  if (wantWrite != connection.writeArmed) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.writeArmed = wantWrite;
+  }
+}
+
+bool ServerLoop::sendPending(Connection& connection) {
+  // Shared buffers were queued before anything now in 'output'; gather them into one call
+  while (!connection.shared.empty()) {
+    iovec chunks[MAX_IOVECS];
+    int count = 0;
+    for (auto it = connection.shared.begin(); it != connection.shared.end() && count < MAX_IOVECS; ++it, ++count) {
+      std::size_t skip = count == 0 ? connection.sharedOffset : 0;
+      chunks[count] = {const_cast<std::uint8_t*>((*it)->data()) + skip, (*it)->size() - skip};
+    }
+    msghdr message{};
+    message.msg_iov = chunks;
+    message.msg_iovlen = static_cast<std::size_t>(count);
+    ssize_t written = ::sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    auto remaining = static_cast<std::size_t>(written);
+    while (remaining > 0) {
+      std::size_t left = connection.shared.front()->size() - connection.sharedOffset;
+      if (remaining < left) {
+        connection.sharedOffset += remaining;
+        break;
+      }
+      remaining -= left;
+      connection.shared.pop_front();
+      connection.sharedOffset = 0;
+    }
+  }
+
+  std::size_t sent = 0;
+  bool healthy = true;
+  while (sent < connection.output.size()) {
+    ssize_t written = ::send(connection.fd, connection.output.data() + sent, connection.output.size() - sent,
+                             MSG_NOSIGNAL);
+    if (written > 0) {
+      sent += static_cast<std::size_t>(written);
+    } else if (written < 0 && errno == EINTR) {
+      continue;
+    } else {
+      healthy = written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+      break;
+    }
+  }
+  connection.output.erase(connection.output.begin(), connection.output.begin() + static_cast<std::ptrdiff_t>(sent));
+  return healthy;
+}
+
+void ServerLoop::closeConnection(Connection& connection) {
+  int fd = connection.fd;
+  ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  if (Table* table = tables.Get(connection.table)) {
+    table->Abandon(connection.seat);
+  }
+  stopWatching(connection);
+  connections[fd].reset();
+}
+
+void ServerLoop::handleFrame(Connection& connection, const Frame& frame) {
+  if (connection.spectator) {
+    PayloadReader payload(frame.payload);
+    std::uint64_t key = payload.U64();
+    if (frame.type == MessageType::Resume && payload.Done()) {
+      resumeSeat(connection, key);
+    } else {
+      startWatching(connection, frame);
+    }
+    return;
+  }
+  Table* table = tables.Get(connection.table);
+  if (table == nullptr) {
+    SendError(outbox(connection), WireError::NotSeated);
+    return;
+  }
+  table->Deliver(connection.seat, frame);
+}
+
+std::vector<std::uint8_t>& ServerLoop::outbox(Connection& connection) {
+  markDirty(connection);
+  return connection.output;
+}
+
+void ServerLoop::share(Connection& connection, const SharedFrames& frames) {
+  if (!connection.output.empty()) {
+    // Keep the order: what is already in the private buffer goes out first
+    connection.shared.push_back(std::make_shared<const std::vector<std::uint8_t>>(std::move(connection.output)));
+    connection.output.clear();
+  }
+  connection.shared.push_back(frames);
+  markDirty(connection);
+}
+
+void ServerLoop::markDirty(Connection& connection) {
+  if (!connection.dirty) {
+    connection.dirty = true;
+    dirtyFds.push_back(connection.fd);
+  }
+}
+
+void ServerLoop::flushDirty() {
+  for (int fd : dirtyFds) {
+    Connection* connection = connections[fd].get();
+    if (connection != nullptr && connection->dirty) {
+      connection->dirty = false;
+      writeTo(*connection);
+    }
+  }
+  dirtyFds.clear();
+}
+
+ConnectionPtr ServerLoop::detach(Connection& connection) {
+  int fd = connection.fd;
+  ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  connection.writeArmed = false;
+  connection.dirty = false;  // Its entry in dirtyFds finds nothing and is skipped
+  return std::move(connections[fd]);
+}
+
+void ServerLoop::enqueueWaiting(ConnectionPtr connection) {
+  // Say so now: the connection is nobody's to flush until a loop adopts it with a table
+  FrameBuilder(connection->output, MessageType::Waiting);
+  if (!sendPending(*connection)) {
+    return;  // Gone already; the destructor closes the socket
+  }
+  Connection& waiting = *connection;
+  if (!matchmaker.Enqueue(std::move(connection))) {
+    SendError(waiting.output, WireError::ServerBusy);
+    sendPending(waiting);
+  }
+}
+
+void ServerLoop::openTables() {
+  ConnectionPtr arrival;
+  while (arrivals.TryPop(arrival)) {
+    Connection& connection = *arrival;
+    std::uint64_t key = std::exchange(connection.resumeKey, 0);
+    adopt(std::move(arrival));
+    resumeSeat(connection, key);
+  }
+
+  std::vector<ConnectionPtr> group;
+  while (inbox.TryPop(group)) {
+    TableHandle handle = tables.Create();
+    Table& table = *tables.Get(handle);
+    table.loop = this;
+    table.handle = handle;
+    table.seats.clear();
+    table.game.SetConfig(options.config);
+    table.game.SetRules(options.config->rules);  // A recycled table may have been restored with others
+    table.game.ResetTable(options.tableSize);
+    table.game.RollDice();
+    table.currentBidRank = 0;
+    table.snapshot.reset();
+    newestTable = handle;
+    const auto& players = table.game.GetPlayers();
+    for (std::size_t seat = 0; seat < group.size(); ++seat) {
+      Connection& connection = *group[seat];
+      connection.table = handle;
+      connection.seat = static_cast<int>(seat);
+      table.seats.push_back({&connection});
+      table.seats.back().key = newSeatKey();
+      adopt(std::move(group[seat]));
+      auto& out = outbox(connection);
+      FrameBuilder(out, MessageType::Seated)
+          .U8(static_cast<std::uint8_t>(seat + 1))
+          .U8(static_cast<std::uint8_t>(options.tableSize))
+          .U64(table.seats.back().key);
+      FrameBuilder(out, MessageType::Dice).Faces(players[seat].GetDice());
+    }
+    scheduler.Spawn(table.game.PlayGameAsync(table), [this, handle] { finishTable(handle); });
+  }
+}
+
+void ServerLoop::finishTable(TableHandle handle) {
+  Table& table = *tables.Get(handle);
+  table.StopClocks();
+  table.ReleaseReservations();
+  if (checkpoint) {
+    checkpoint->Clear(handle.index);
+  }
+  const GameOutcome& outcome = table.game.GetLastOutcome();
+
+  // The reveal is the same for every seat and watcher, so it is encoded once
+  std::vector<std::uint8_t> bytes;
+  for (const auto& player : table.game.GetPlayers()) {
+    FrameBuilder(bytes, MessageType::Reveal)
+        .U8(static_cast<std::uint8_t>(player.GetPlayerId()))
+        .Faces(player.GetDice());
+  }
+  FrameBuilder(bytes, MessageType::Result)
+      .U8(outcome.guesserWon ? 0 : 1)
+      .U32(BidRank(outcome.finalDiceCount, outcome.finalDiceValue))
+      .U16(static_cast<std::uint16_t>(outcome.actualCount));
+  auto reveal = std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes));
+
+  table.Publish(reveal);
+  for (Connection* watcher : table.watchers) {
+    watcher->watching = {};
+  }
+  table.watchers.clear();
+
+  // Everyone still connected goes back in line for the next table, possibly on another loop
+  for (auto& seat : table.seats) {
+    if (seat.connection != nullptr) {
+      share(*seat.connection, reveal);
+      seat.connection->table = {};
+      seat.connection->seat = -1;
+      enqueueWaiting(detach(*std::exchange(seat.connection, nullptr)));
+    }
+  }
+
+  tables.Destroy(handle);
+}
+
+void ServerLoop::resumeSeat(Connection& connection, std::uint64_t key) {
+  if (!peers.empty() && peers[OwnerOf(key, peers.size())] != this) {
+    connection.resumeKey = key;  // readFrom hands the connection over once its frames are read
+    return;
+  }
+  auto reserved = reservedSeats.find(key);
+  Table* table = reserved == reservedSeats.end() ? nullptr : tables.Get(reserved->second.first);
+  if (table == nullptr || key == 0) {
+    SendError(outbox(connection), WireError::NoSuchTable);
+    return;
+  }
+
+  // The connection stops being a spectator and plays from now on
+  int seat = reserved->second.second;
+  reservedSeats.erase(reserved);
+  stopWatching(connection);
+  connection.spectator = false;
+  connection.table = table->handle;
+  connection.seat = seat;
+  table->Reclaim(seat, connection);
+}
+
+std::uint64_t ServerLoop::newSeatKey() {
+  std::uint64_t key;
+  do {
+    key = std::uint64_t{index} << 56 | seatKeys() >> 8;
+  } while (key == 0);
+  return key;
+}
+
+void ServerLoop::checkpointTable(const Table& table, bool awaiting_call) {
+  if (!checkpoint) {
+    return;
+  }
+  const Game& game = table.game;
+  std::vector<std::uint8_t>& record = checkpointRecord;
+  record.clear();
+  AppendInteger(record, game.GetPlayers().size(), 1);
+  AppendInteger(record, static_cast<std::uint64_t>(game.GetCurrentPlayerIndex()), 1);
+  AppendInteger(record, awaiting_call ? 1 : 0, 1);
+  AppendInteger(record, game.GetRules().Index(), 1);
+  AppendInteger(record, RankOf(game.GetLastGuess()), 4);
+  for (std::size_t seat = 0; seat < table.seats.size(); ++seat) {
+    const auto& dice = game.GetPlayers()[seat].GetDice();
+    AppendInteger(record, table.seats[seat].key, 8);
+    AppendInteger(record, dice.size(), 1);
+    for (std::size_t i = 0; i < dice.size(); i += 2) {
+      unsigned high = i + 1 < dice.size() ? dice[i + 1].GetFaceValue() : 0;
+      record.push_back(static_cast<std::uint8_t>((dice[i].GetFaceValue() & 0xF) | (high & 0xF) << 4));
+    }
+  }
+  // Records fit every table (see RestoreCheckpoints), so only tables past MAX_CHECKPOINT_TABLES are not kept
+  checkpoint->Write(table.handle.index, record);
+}
+
+bool ServerLoop::restoreTable(std::span<const std::uint8_t> record) {
+  PayloadReader payload(record);
+  int players = payload.U8();
+  int current = payload.U8();
+  bool awaitingCall = payload.U8() != 0;
+  unsigned rules = payload.U8();
+  Guess lastGuess(BidFromRank(payload.U32()));
+  std::vector<std::uint64_t> keys;
+  std::vector<std::vector<std::uint8_t>> faces(players);
+  for (int seat = 0; seat < players; ++seat) {
+    keys.push_back(payload.U64());
+    std::size_t count = payload.U8();
+    for (std::size_t i = 0; i < count; i += 2) {
+      std::uint8_t packed = payload.U8();
+      faces[seat].push_back(packed & 0xF);
+      if (i + 1 < count) {
+        faces[seat].push_back(packed >> 4);
+      }
+    }
+  }
+  auto badFace = [this](std::uint8_t face) { return face < 1 || face > options.config->faces; };
+  if (!payload.Done() || players < 2 || rules >= kRuleVariantCount ||
+      std::ranges::any_of(faces, [&](const auto& dice) { return std::ranges::any_of(dice, badFace); })) {
+    return false;
+  }
+  int dice = 0;
+  for (const auto& seatDice : faces) {
+    dice += static_cast<int>(seatDice.size());
+  }
+  if (RankOf(lastGuess) != 0 && !IsPossibleBid(lastGuess, options.config->faces, dice)) {
+    return false;
+  }
+
+  TableHandle handle = tables.Create();
+  Table& table = *tables.Get(handle);
+  table.loop = this;
+  table.handle = handle;
+  table.seats.clear();
+  table.game.SetConfig(options.config);
+  table.game.SetRules(RuleVariant::FromIndex(rules));
+  table.game.ResetTable(players);
+  try {
+    for (int seat = 0; seat < players; ++seat) {
+      table.game.SetPlayerDice(seat + 1, faces[seat]);
+    }
+    table.game.RestoreTurn(current, lastGuess, awaitingCall);
+  } catch (const GameLogicException&) {
+    tables.Destroy(handle);
+    return false;
+  }
+  table.currentBidRank = RankOf(lastGuess);
+  table.snapshot.reset();
+  newestTable = handle;
+
+  // Every seat waits for its player to come back with the key; the clocks give up on them
+  for (int seat = 0; seat < players; ++seat) {
+    table.seats.push_back({.key = keys[seat], .reserved = true});
+    reservedSeats[keys[seat]] = {handle, seat};
+  }
+  scheduler.Spawn(table.game.PlayGameAsync(table), [this, handle] { finishTable(handle); });
+  return true;
+}
+
+void ServerLoop::startWatching(Connection& spectator, const Frame& frame) {
+  PayloadReader payload(frame.payload);
+  std::uint32_t id = payload.U32();
+  if (frame.type != MessageType::Watch || !payload.Done()) {
+    SendError(outbox(spectator), WireError::Malformed);
+    return;
+  }
+
+  // Table ids are slot indices plus one; 0 asks for the newest table still in play
+  TableHandle handle = id == 0 ? newestTable : tables.HandleAt(id - 1);
+  if (id == 0 && tables.Get(handle) == nullptr) {
+    tables.ForEach([&handle](TableHandle live, Table&) { handle = live; });
+  }
+  Table* table = tables.Get(handle);
+  if (table == nullptr) {
+    SendError(outbox(spectator), WireError::NoSuchTable);
+    return;
+  }
+
+  stopWatching(spectator);
+  spectator.watching = handle;
+  spectator.watchIndex = table->watchers.size();
+  table->watchers.push_back(&spectator);
+  FrameBuilder(outbox(spectator), MessageType::Watching)
+      .U32(handle.index + 1)
+      .U8(static_cast<std::uint8_t>(table->seats.size()));
+  share(spectator, table->Snapshot());
+}
+
+void ServerLoop::stopWatching(Connection& spectator) {
+  Table* table = tables.Get(spectator.watching);
+  if (table == nullptr) {
+    return;
+  }
+  auto& watchers = table->watchers;
+  watchers[spectator.watchIndex] = watchers.back();
+  watchers[spectator.watchIndex]->watchIndex = spectator.watchIndex;
+  watchers.pop_back();
+  spectator.watching = {};
+}
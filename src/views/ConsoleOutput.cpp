@@ -0,0 +1,97 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the console output buffering.
+//
+
+#include "ConsoleOutput.hpp"
+#include <array>
+#include <cerrno>
+#include <iostream>
+#include <streambuf>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t OUTPUT_BUFFER_SIZE = 1 << 16;
+
+// Collects output for a file descriptor and writes it in as few calls as possible
+class DescriptorBuffer : public std::streambuf {
+public:
+  explicit DescriptorBuffer(int fd) : fd(fd) { setp(buffer.data(), buffer.data() + buffer.size()); }
+
+protected:
+  int_type overflow(int_type c) override {
+    drain();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* data, std::streamsize count) override {
+    auto size = static_cast<std::size_t>(count);
+    if (size > static_cast<std::size_t>(epptr() - pptr())) {
+      drain();
+      if (size >= buffer.size()) {
+        WriteFully(fd, {data, size});  // Too big to be worth copying
+        return count;
+      }
+    }
+    traits_type::copy(pptr(), data, size);
+    pbump(static_cast<int>(size));
+    return count;
+  }
+
+  int sync() override {
+    drain();
+    return 0;
+  }
+
+private:
+  int fd;
+  std::array<char, OUTPUT_BUFFER_SIZE> buffer;
+
+  void drain() {
+    WriteFully(fd, {pbase(), static_cast<std::size_t>(pptr() - pbase())});
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+};
+
+} // namespace
+
+void BufferConsoleOutput() {
+  // Never destroyed: std::cout flushes through it during exit, after static objects are gone
+  static auto* output = new DescriptorBuffer(1);
+  std::ios::sync_with_stdio(false);
+  std::cout.rdbuf(output);
+  std::cin.tie(nullptr);
+}
+
+void FlushConsoleOutput() {
+  if (std::cin.rdbuf()->in_avail() <= 0) {
+    std::cout.flush();  // The player has to see the prompt before answering it
+  }
+}
+
+void WriteFully(int fd, std::string_view data) {
+  while (!data.empty()) {
+#ifdef _WIN32
+    int written = ::_write(fd, data.data(), static_cast<unsigned>(data.size()));
+#else
+    ssize_t written = ::write(fd, data.data(), data.size());
+#endif
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return;  // Nowhere to write; the game goes on without its output
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
@@ -0,0 +1,139 @@
+//
+// Created by Brett on 10/16/2026.
+// This file contains the implementation of the TerminalRenderer class.
+//
+
+#include "TerminalRenderer.hpp"
+#include "ConsoleOutput.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#endif
+
+namespace {
+
+constexpr std::string_view CLEAR_SCREEN = "\x1b[H\x1b[2J";  // Home the cursor, then erase the screen
+constexpr std::string_view ERASE_LINE = "\x1b[K";          // From the cursor to the end of the line
+constexpr std::string_view ERASE_BELOW = "\x1b[J";         // From the cursor to the end of the screen
+
+void SplitLines(std::string_view text, std::vector<std::string_view>& lines) {
+  lines.clear();
+  while (true) {
+    std::size_t end = text.find('\n');
+    lines.push_back(text.substr(0, end));
+    if (end == std::string_view::npos) {
+      return;
+    }
+    text.remove_prefix(end + 1);
+  }
+}
+
+// The screen column of byte 'offset' of a line, moved back to the start of a UTF-8 character.
+// Returns the byte offset it settled on; a tab before it sends the line back to column 0.
+std::size_t CellColumn(std::string_view line, std::size_t& offset) {
+  while (offset > 0 && offset < line.size() && (static_cast<unsigned char>(line[offset]) & 0xC0) == 0x80) {
+    --offset;
+  }
+  std::string_view prefix = line.substr(0, offset);
+  if (prefix.find('\t') != std::string_view::npos) {
+    offset = 0;
+    return 0;
+  }
+  return static_cast<std::size_t>(
+      std::ranges::count_if(prefix, [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+}
+
+#ifdef _WIN32
+// The Windows console only understands ANSI sequences once asked to
+bool EnableVirtualTerminal() {
+  HANDLE console = ::GetStdHandle(STD_OUTPUT_HANDLE);
+  DWORD mode = 0;
+  return console != INVALID_HANDLE_VALUE && ::GetConsoleMode(console, &mode) &&
+         ::SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+}
+#endif
+
+} // namespace
+
+TerminalRenderer::TerminalRenderer(int fd) : fd(fd) {}
+
+void TerminalRenderer::BeginFrame() {
+  frame.clear();
+}
+
+void TerminalRenderer::Present() {
+#ifdef _WIN32
+  [[maybe_unused]] static const bool virtualTerminal = EnableVirtualTerminal();
+#endif
+  SplitLines(frame, frameLines);
+  output.clear();
+  std::size_t redrawFrom = 0;  // Rows from here down are cleared and drawn again
+  if (!shownValid || !fitsTerminal(frameLines.size())) {
+    output.append(CLEAR_SCREEN);
+  } else {
+    // Every row above the previous prompt still shows the previous frame
+    SplitLines(shown, shownLines);
+    redrawFrom = std::min(shownLines.size(), frameLines.size()) - 1;
+    for (std::size_t row = 0; row < redrawFrom; ++row) {
+      std::string_view before = shownLines[row];
+      std::string_view after = frameLines[row];
+      if (before == after) {
+        continue;
+      }
+      auto offset = static_cast<std::size_t>(std::ranges::mismatch(before, after).in2 - after.begin());
+      appendCursorMove(row, CellColumn(after, offset));
+      output.append(after.substr(offset));
+      if (before.size() != after.size()) {
+        output.append(ERASE_LINE);
+      }
+    }
+    appendCursorMove(redrawFrom, 0);
+    output.append(ERASE_BELOW);
+  }
+  for (std::size_t row = redrawFrom; row < frameLines.size(); ++row) {
+    if (row > redrawFrom) {
+      output.push_back('\n');
+    }
+    output.append(frameLines[row]);
+  }
+
+  if (fd == kStandardOutput) {
+    std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));  // Sent with the prompt
+  } else {
+    std::cout.flush();
+    WriteFully(fd, output);
+  }
+  shown.assign(frame);
+  shownValid = true;
+}
+
+void TerminalRenderer::appendNumber(long long value) {
+  char digits[24];
+  auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+  frame.append(digits, end);
+}
+
+void TerminalRenderer::appendCursorMove(std::size_t row, std::size_t column) {
+  char digits[24];
+  output.append("\x1b[");
+  output.append(digits, std::to_chars(digits, digits + sizeof(digits), row + 1).ptr);
+  output.push_back(';');
+  output.append(digits, std::to_chars(digits, digits + sizeof(digits), column + 1).ptr);
+  output.push_back('H');
+}
+
+bool TerminalRenderer::fitsTerminal(std::size_t lines) const {
+#ifdef _WIN32
+  return true;
+#else
+  // The frame, the line the player types and one more prompt must fit without scrolling, or the
+  // rows of the previous frame are no longer where they were drawn
+  winsize size{};
+  return ::ioctl(fd, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || lines + 2 <= size.ws_row;
+#endif
+}